@@ -0,0 +1,328 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "RingBuffer.h"
+
+#if defined(_WIN32)
+#undef min
+#undef max
+#else
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+enum class LogOverflowPolicy
+{
+    Block,      // wait for the writer to make room
+    DropNewest, // discard the record being logged
+    DropOldest  // discard the oldest queued record to make room
+};
+
+struct AsyncLogOptions
+{
+    size_t Capacity = 4096;  // queued records, rounded up to a power of two
+    size_t BatchSize = 64;   // records per write call
+    LogOverflowPolicy Overflow = LogOverflowPolicy::Block;
+    bool ReportDrops = true; // write a text notice after records were dropped
+    std::FILE* Output = stdout;
+};
+
+// Background writer: producers copy preformatted lines into a lock-free ring,
+// a dedicated thread drains them in batches with a single write per batch.
+class AsyncLogWriter
+{
+public:
+    static constexpr size_t InlineCapacity = 240;
+    static constexpr size_t MaxBatchSize = 1024;
+
+    explicit AsyncLogWriter(const AsyncLogOptions& options = {})
+        : m_options(options), m_queue(options.Capacity)
+    {
+        if (m_options.BatchSize == 0)
+            m_options.BatchSize = 1;
+        if (m_options.BatchSize > MaxBatchSize)
+            m_options.BatchSize = MaxBatchSize;
+
+        m_thread = std::thread([this] { Run(); });
+    }
+
+    // Drains everything still queued before returning.
+    ~AsyncLogWriter()
+    {
+        m_running.store(false, std::memory_order_release);
+        Wake();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    // Queues the concatenation of parts as one record. Returns false if the record was dropped.
+    bool Enqueue(std::initializer_list<std::string_view> parts)
+    {
+        return Enqueue(parts, m_options.Overflow);
+    }
+
+    // Same, with the overflow policy chosen per call; records that later ones depend on
+    // can be queued with Block even when the writer drops on overflow.
+    bool Enqueue(std::initializer_list<std::string_view> parts, LogOverflowPolicy overflow)
+    {
+        uint64_t pos;
+        while (!m_queue.TryClaimWrite(pos))
+        {
+            switch (overflow)
+            {
+            case LogOverflowPolicy::DropNewest:
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+
+            case LogOverflowPolicy::DropOldest:
+            {
+                uint64_t oldest;
+                if (m_queue.TryClaimRead(oldest))
+                {
+                    m_queue.At(oldest).Clear();
+                    m_queue.Release(oldest);
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                break;
+            }
+
+            case LogOverflowPolicy::Block:
+                break;
+            }
+
+            Wake();
+            std::this_thread::yield();
+        }
+
+        m_queue.At(pos).Assign(parts);
+        m_queue.Publish(pos);
+        WakeIfWaiting();
+        return true;
+    }
+
+    // Blocks until every record queued before the call has been written.
+    void Flush()
+    {
+        const uint64_t target = m_queue.WritePosition();
+        uint64_t done = m_completed.load(std::memory_order_acquire);
+        while (done < target)
+        {
+            Wake();
+            m_completed.wait(done, std::memory_order_acquire);
+            done = m_completed.load(std::memory_order_acquire);
+        }
+    }
+
+    uint64_t GetDroppedCount() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Record
+    {
+        uint32_t length = 0;
+        char text[InlineCapacity];
+        std::string overflow; // only used for lines longer than InlineCapacity
+
+        void Assign(std::initializer_list<std::string_view> parts)
+        {
+            size_t total = 0;
+            for (auto part : parts)
+                total += part.size();
+
+            length = static_cast<uint32_t>(total);
+            char* out = text;
+            if (total > InlineCapacity)
+            {
+                overflow.resize(total);
+                out = overflow.data();
+            }
+
+            for (auto part : parts)
+            {
+                std::memcpy(out, part.data(), part.size());
+                out += part.size();
+            }
+        }
+
+        std::string_view View() const
+        {
+            return length > InlineCapacity ? std::string_view(overflow) : std::string_view(text, length);
+        }
+
+        void Clear()
+        {
+            if (overflow.capacity() > 4 * InlineCapacity)
+                std::string().swap(overflow);
+            length = 0;
+        }
+    };
+
+    void Wake()
+    {
+        m_signal.fetch_add(1, std::memory_order_release);
+        m_signal.notify_one();
+    }
+
+    // Hot path: only pay for the notify when the writer is actually asleep.
+    void WakeIfWaiting()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting.load(std::memory_order_relaxed))
+            Wake();
+    }
+
+    void Run()
+    {
+        std::vector<uint64_t> claimed(m_options.BatchSize);
+        uint64_t reportedDrops = 0;
+
+        for (;;)
+        {
+            size_t count = 0;
+            while (count < claimed.size() && m_queue.TryClaimRead(claimed[count]))
+                ++count;
+
+            if (count == 0)
+            {
+                MarkCompleted(m_queue.ReadPosition());
+                if (!m_running.load(std::memory_order_acquire) && m_queue.ReadPosition() == m_queue.WritePosition())
+                    break;
+
+                const uint32_t seen = m_signal.load(std::memory_order_acquire);
+                m_waiting.store(true, std::memory_order_seq_cst);
+                if (m_queue.ReadPosition() != m_queue.WritePosition())
+                    std::this_thread::yield(); // a producer is mid-publish
+                else if (m_running.load(std::memory_order_acquire))
+                    m_signal.wait(seen, std::memory_order_acquire);
+                m_waiting.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            WriteBatch(claimed.data(), count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_queue.At(claimed[i]).Clear();
+                m_queue.Release(claimed[i]);
+            }
+            MarkCompleted(claimed[count - 1] + 1);
+
+            const uint64_t drops = m_dropped.load(std::memory_order_relaxed);
+            if (drops != reportedDrops && m_options.ReportDrops)
+            {
+                std::string notice = "[ASYNCLOG] " + std::to_string(drops - reportedDrops) + " log record(s) dropped, queue full\n";
+                WriteAll(notice.data(), notice.size());
+                reportedDrops = drops;
+            }
+        }
+
+        std::fflush(m_options.Output);
+    }
+
+    void MarkCompleted(uint64_t pos)
+    {
+        if (pos > m_completed.load(std::memory_order_relaxed))
+        {
+            m_completed.store(pos, std::memory_order_release);
+            m_completed.notify_all();
+        }
+    }
+
+#if defined(_WIN32)
+    void WriteBatch(const uint64_t* positions, size_t count)
+    {
+        m_scratch.clear();
+        for (size_t i = 0; i < count; ++i)
+            m_scratch.append(m_queue.At(positions[i]).View());
+        WriteAll(m_scratch.data(), m_scratch.size());
+    }
+
+    void WriteAll(const char* data, size_t size)
+    {
+        std::fwrite(data, 1, size, m_options.Output);
+        std::fflush(m_options.Output);
+    }
+
+    std::string m_scratch;
+#else
+    void WriteBatch(const uint64_t* positions, size_t count)
+    {
+        iovec iov[MaxBatchSize];
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto text = m_queue.At(positions[i]).View();
+            iov[i].iov_base = const_cast<char*>(text.data());
+            iov[i].iov_len = text.size();
+        }
+
+        const int fd = fileno(m_options.Output);
+        iovec* cur = iov;
+        int remaining = static_cast<int>(count);
+        while (remaining > 0)
+        {
+            ssize_t written = ::writev(fd, cur, remaining);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return; // nowhere left to report it
+            }
+
+            // Skip fully written entries and trim a partially written one.
+            while (remaining > 0 && static_cast<size_t>(written) >= cur->iov_len)
+            {
+                written -= static_cast<ssize_t>(cur->iov_len);
+                ++cur;
+                --remaining;
+            }
+            if (remaining > 0)
+            {
+                cur->iov_base = static_cast<char*>(cur->iov_base) + written;
+                cur->iov_len -= static_cast<size_t>(written);
+            }
+        }
+    }
+
+    void WriteAll(const char* data, size_t size)
+    {
+        iovec iov{ const_cast<char*>(data), size };
+        const int fd = fileno(m_options.Output);
+        while (iov.iov_len > 0)
+        {
+            ssize_t written = ::writev(fd, &iov, 1);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            iov.iov_base = static_cast<char*>(iov.iov_base) + written;
+            iov.iov_len -= static_cast<size_t>(written);
+        }
+    }
+#endif
+
+private:
+    AsyncLogOptions m_options;
+    utils::LockFreeRingBuffer<Record> m_queue;
+
+    std::atomic<bool> m_running{ true };
+    std::atomic<uint32_t> m_signal{ 0 };
+    std::atomic<bool> m_waiting{ false };
+    std::atomic<uint64_t> m_completed{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+
+    std::thread m_thread;
+};
\ No newline at end of file
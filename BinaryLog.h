@@ -0,0 +1,511 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "CustomRaylibLog.h"
+#include "GameTime.h"
+
+// Binary log stream layout (host byte order):
+//   header:  "GUBLOG01"
+//   record:  u8 kind, u32 payload size, payload
+//   Define:  u32 id, u32 level, u16 tag size, tag, u16 format size, format, u8 arg count, u8 arg types[]
+//   Event:   u32 id, u64 timestamp (ns since GameTime start), encoded args
+// Strings are encoded as u32 size followed by the bytes, everything else as its raw bytes.
+// A null C string is encoded as the text "(null)".
+
+enum class BinaryLogArgType : uint8_t
+{
+    Bool, Char, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double, String, Pointer
+};
+
+template<typename... Args>
+struct BinaryLogArgs {};
+
+class BinaryLog
+{
+public:
+    static constexpr char Magic[8] = { 'G', 'U', 'B', 'L', 'O', 'G', '0', '1' };
+    enum class RecordKind : uint8_t { Define = 1, Event = 2 };
+
+    // Starts writing binary records to path. Formats registered earlier are written first.
+    // Define records always wait for room: dropping one would orphan every event that uses
+    // it, so options.Overflow applies to events only. Drops are counted but never reported
+    // in the stream, which has to stay binary; see GetDroppedCount().
+    static bool Open(const std::string& path, AsyncLogOptions options = {})
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.m_mutex);
+        if (instance.m_writer.IsSet())
+            return false;
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+        std::fwrite(Magic, 1, sizeof(Magic), file);
+        std::fflush(file);
+
+        options.Output = file;
+        options.ReportDrops = false;
+        instance.m_file = file;
+        auto writer = std::make_unique<AsyncLogWriter>(options);
+        for (const auto& definition : instance.m_definitions)
+            writer->Enqueue({ definition }, LogOverflowPolicy::Block);
+
+        instance.m_writer.Reset(std::move(writer));
+        return true;
+    }
+
+    // Drains pending records and closes the file. Safe to call while other threads
+    // write: it waits for writes already in progress, and later ones are dropped.
+    static void Close()
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.m_mutex);
+        instance.m_writer.Reset();
+        if (instance.m_file)
+        {
+            std::fclose(instance.m_file);
+            instance.m_file = nullptr;
+        }
+    }
+
+    static bool IsOpen()
+    {
+        return GetInstance().m_writer.IsSet();
+    }
+
+    static void Flush()
+    {
+        if (WriterRef writer(GetInstance().m_writer); writer)
+            writer->Flush();
+    }
+
+    // Events dropped by the overflow policy since Open().
+    static uint64_t GetDroppedCount()
+    {
+        WriterRef writer(GetInstance().m_writer);
+        return writer ? writer->GetDroppedCount() : 0;
+    }
+
+    // Assigns an id to a call site's format. Called once per site by TRACELOG_BINARY.
+    template<typename... Args>
+    static uint32_t RegisterFormat(LogLevel level, std::string_view tagStr, std::string_view format, BinaryLogArgs<Args...>)
+    {
+        static_assert(sizeof...(Args) < 256, "Too many arguments for a binary log record.");
+        const uint8_t types[] = { static_cast<uint8_t>(ArgType<Args>())..., 0 };
+
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.m_mutex);
+        const uint32_t id = static_cast<uint32_t>(instance.m_definitions.size());
+
+        std::string payload;
+        AppendRaw(payload, id);
+        AppendRaw(payload, static_cast<uint32_t>(level));
+        AppendRaw(payload, static_cast<uint16_t>(tagStr.size()));
+        payload.append(tagStr.substr(0, static_cast<uint16_t>(tagStr.size())));
+        AppendRaw(payload, static_cast<uint16_t>(format.size()));
+        payload.append(format.substr(0, static_cast<uint16_t>(format.size())));
+        AppendRaw(payload, static_cast<uint8_t>(sizeof...(Args)));
+        payload.append(reinterpret_cast<const char*>(types), sizeof...(Args));
+
+        std::string record;
+        AppendRaw(record, RecordKind::Define);
+        AppendRaw(record, static_cast<uint32_t>(payload.size()));
+        record += payload;
+
+        if (WriterRef writer(instance.m_writer); writer)
+            writer->Enqueue({ record }, LogOverflowPolicy::Block);
+        instance.m_definitions.push_back(std::move(record));
+        return id;
+    }
+
+    // Writes one event: format id, timestamp and raw argument bytes, no text formatting.
+    template<typename... Args>
+    static void Write(uint32_t id, const Args&... args)
+    {
+        WriterRef writer(GetInstance().m_writer);
+        if (!writer)
+            return;
+
+        constexpr size_t headerSize = sizeof(RecordKind) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+        const size_t size = headerSize + (size_t{ 0 } + ... + EncodedSize(args));
+        const uint64_t timestamp = static_cast<uint64_t>(GameTime::GetElapsedTime<std::chrono::nanoseconds>().count());
+
+        char stackBuffer[AsyncLogWriter::InlineCapacity];
+        std::string heapBuffer;
+        char* out = stackBuffer;
+        if (size > sizeof(stackBuffer))
+        {
+            heapBuffer.resize(size);
+            out = heapBuffer.data();
+        }
+
+        char* cursor = out;
+        cursor = EncodeRaw(cursor, RecordKind::Event);
+        cursor = EncodeRaw(cursor, static_cast<uint32_t>(size - sizeof(RecordKind) - sizeof(uint32_t)));
+        cursor = EncodeRaw(cursor, id);
+        cursor = EncodeRaw(cursor, timestamp);
+        ((cursor = Encode(cursor, args)), ...);
+
+        writer->Enqueue({ std::string_view(out, size) });
+    }
+
+    // Unevaluated helper used by TRACELOG_BINARY to capture argument types.
+    template<typename... Args>
+    static BinaryLogArgs<std::decay_t<Args>...> Signature(Args&&...);
+
+    template<typename T>
+    static constexpr BinaryLogArgType ArgType()
+    {
+        using U = std::remove_cv_t<T>;
+        if constexpr (std::is_same_v<U, bool>) return BinaryLogArgType::Bool;
+        else if constexpr (std::is_same_v<U, char>) return BinaryLogArgType::Char;
+        else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+        {
+            if constexpr (sizeof(U) == 1) return BinaryLogArgType::Int8;
+            else if constexpr (sizeof(U) == 2) return BinaryLogArgType::Int16;
+            else if constexpr (sizeof(U) == 4) return BinaryLogArgType::Int32;
+            else return BinaryLogArgType::Int64;
+        }
+        else if constexpr (std::is_integral_v<U>)
+        {
+            if constexpr (sizeof(U) == 1) return BinaryLogArgType::UInt8;
+            else if constexpr (sizeof(U) == 2) return BinaryLogArgType::UInt16;
+            else if constexpr (sizeof(U) == 4) return BinaryLogArgType::UInt32;
+            else return BinaryLogArgType::UInt64;
+        }
+        else if constexpr (std::is_same_v<U, float>) return BinaryLogArgType::Float;
+        else if constexpr (std::is_floating_point_v<U>) return BinaryLogArgType::Double;
+        else if constexpr (std::is_convertible_v<const U&, std::string_view>) return BinaryLogArgType::String;
+        else if constexpr (std::is_pointer_v<U>) return BinaryLogArgType::Pointer;
+        else
+        {
+            static_assert(sizeof(U) == 0, "Unsupported binary log argument type.");
+            return BinaryLogArgType::Pointer;
+        }
+    }
+
+private:
+    BinaryLog() = default;
+    ~BinaryLog()
+    {
+        m_writer.Reset();
+        if (m_file)
+            std::fclose(m_file);
+    }
+
+    static BinaryLog& GetInstance()
+    {
+        static BinaryLog instance;
+        return instance;
+    }
+
+    // Pins the open writer for one call; Close() waits for pinned calls before stopping it.
+    using WriterRef = PinnedPtr<AsyncLogWriter>::Ref;
+
+    template<typename T>
+    static std::string_view TextOf(const T& value)
+    {
+        if constexpr (std::is_pointer_v<T>)
+        {
+            if (!value)
+                return "(null)";
+        }
+        return std::string_view(value);
+    }
+
+    template<typename T>
+    static size_t EncodedSize(const T& value)
+    {
+        constexpr BinaryLogArgType type = ArgType<std::decay_t<T>>();
+        if constexpr (type == BinaryLogArgType::String)
+            return sizeof(uint32_t) + TextOf(value).size();
+        else if constexpr (type == BinaryLogArgType::Pointer)
+            return sizeof(uint64_t);
+        else if constexpr (type == BinaryLogArgType::Double)
+            return sizeof(double);
+        else
+            return sizeof(T);
+    }
+
+    template<typename T>
+    static char* Encode(char* out, const T& value)
+    {
+        constexpr BinaryLogArgType type = ArgType<std::decay_t<T>>();
+        if constexpr (type == BinaryLogArgType::String)
+        {
+            const std::string_view text = TextOf(value);
+            out = EncodeRaw(out, static_cast<uint32_t>(text.size()));
+            std::memcpy(out, text.data(), text.size());
+            return out + text.size();
+        }
+        else if constexpr (type == BinaryLogArgType::Pointer)
+            return EncodeRaw(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        else if constexpr (type == BinaryLogArgType::Double)
+            return EncodeRaw(out, static_cast<double>(value));
+        else
+            return EncodeRaw(out, value);
+    }
+
+    template<typename T>
+    static char* EncodeRaw(char* out, const T& value)
+    {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+
+    template<typename T>
+    static void AppendRaw(std::string& out, const T& value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    std::mutex m_mutex;
+    std::vector<std::string> m_definitions; // encoded Define records, index == id
+    PinnedPtr<AsyncLogWriter> m_writer; // reset only under m_mutex, unset while closed
+    std::FILE* m_file = nullptr;
+};
+
+// Turns a binary log stream back into the text TraceLog::Log would have printed.
+class BinaryLogDecoder
+{
+public:
+    // Returns false if the stream is not a binary log or is truncated mid-record.
+    static bool Decode(std::istream& in, std::ostream& out, bool showTimestamps = false)
+    {
+        char magic[sizeof(BinaryLog::Magic)];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, BinaryLog::Magic, sizeof(magic)) != 0)
+            return false;
+
+        std::vector<Definition> definitions;
+        std::string payload;
+        for (;;)
+        {
+            BinaryLog::RecordKind kind;
+            uint32_t size;
+            if (!in.read(reinterpret_cast<char*>(&kind), sizeof(kind)))
+                return true; // clean end of stream
+            if (!in.read(reinterpret_cast<char*>(&size), sizeof(size)))
+                return false;
+
+            payload.resize(size);
+            if (!in.read(payload.data(), size))
+                return false;
+
+            Reader reader{ payload };
+            if (kind == BinaryLog::RecordKind::Define)
+            {
+                Definition definition;
+                uint32_t id = reader.Read<uint32_t>();
+                definition.level = static_cast<LogLevel>(reader.Read<uint32_t>());
+                definition.tag = reader.ReadBytes(reader.Read<uint16_t>());
+                definition.format = reader.ReadBytes(reader.Read<uint16_t>());
+                uint8_t count = reader.Read<uint8_t>();
+                for (uint8_t i = 0; i < count; ++i)
+                    definition.types.push_back(static_cast<BinaryLogArgType>(reader.Read<uint8_t>()));
+
+                if (definitions.size() <= id)
+                    definitions.resize(id + 1);
+                definitions[id] = std::move(definition);
+            }
+            else if (kind == BinaryLog::RecordKind::Event)
+            {
+                uint32_t id = reader.Read<uint32_t>();
+                uint64_t timestamp = reader.Read<uint64_t>();
+                if (id >= definitions.size())
+                    continue; // definition lost, nothing to format with
+
+                const Definition& definition = definitions[id];
+                std::vector<Value> values;
+                for (auto type : definition.types)
+                    values.push_back(ReadValue(reader, type));
+
+                if (showTimestamps)
+                    out << std::format("[{:.6f}] ", timestamp / 1e9);
+                out << TraceLog::FormatPrefix(definition.level, definition.tag)
+                    << FormatMessage(definition.format, values) << '\n';
+            }
+        }
+    }
+
+private:
+    struct Definition
+    {
+        LogLevel level = LogLevel::LOG_LEVEL_NONE;
+        std::string tag;
+        std::string format;
+        std::vector<BinaryLogArgType> types;
+    };
+
+    struct Value
+    {
+        BinaryLogArgType type;
+        union
+        {
+            bool b;
+            char c;
+            int64_t i;
+            uint64_t u;
+            double d;
+        };
+        std::string text;
+    };
+
+    struct Reader
+    {
+        std::string_view data;
+        size_t offset = 0;
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            if (offset + sizeof(T) <= data.size())
+                std::memcpy(&value, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        std::string ReadBytes(size_t size)
+        {
+            std::string value(offset < data.size() ? data.substr(offset, size) : std::string_view());
+            offset += size;
+            return value;
+        }
+    };
+
+    static Value ReadValue(Reader& reader, BinaryLogArgType type)
+    {
+        Value value{};
+        value.type = type;
+        switch (type)
+        {
+        case BinaryLogArgType::Bool:    value.b = reader.Read<bool>(); break;
+        case BinaryLogArgType::Char:    value.c = reader.Read<char>(); break;
+        case BinaryLogArgType::Int8:    value.i = reader.Read<int8_t>(); break;
+        case BinaryLogArgType::Int16:   value.i = reader.Read<int16_t>(); break;
+        case BinaryLogArgType::Int32:   value.i = reader.Read<int32_t>(); break;
+        case BinaryLogArgType::Int64:   value.i = reader.Read<int64_t>(); break;
+        case BinaryLogArgType::UInt8:   value.u = reader.Read<uint8_t>(); break;
+        case BinaryLogArgType::UInt16:  value.u = reader.Read<uint16_t>(); break;
+        case BinaryLogArgType::UInt32:  value.u = reader.Read<uint32_t>(); break;
+        case BinaryLogArgType::UInt64:  value.u = reader.Read<uint64_t>(); break;
+        case BinaryLogArgType::Float:   value.d = reader.Read<float>(); break;
+        case BinaryLogArgType::Double:  value.d = reader.Read<double>(); break;
+        case BinaryLogArgType::Pointer: value.u = reader.Read<uint64_t>(); break;
+        case BinaryLogArgType::String:  value.text = reader.ReadBytes(reader.Read<uint32_t>()); break;
+        }
+        return value;
+    }
+
+    // Formats a single argument with the spec found between ':' and '}'.
+    static std::string FormatValue(const Value& value, std::string_view spec)
+    {
+        const std::string fmt = "{:" + std::string(spec) + "}";
+        try
+        {
+            switch (value.type)
+            {
+            case BinaryLogArgType::Bool:    return std::vformat(fmt, std::make_format_args(value.b));
+            case BinaryLogArgType::Char:    return std::vformat(fmt, std::make_format_args(value.c));
+            case BinaryLogArgType::Int8:
+            case BinaryLogArgType::Int16:
+            case BinaryLogArgType::Int32:
+            case BinaryLogArgType::Int64:   return std::vformat(fmt, std::make_format_args(value.i));
+            case BinaryLogArgType::UInt8:
+            case BinaryLogArgType::UInt16:
+            case BinaryLogArgType::UInt32:
+            case BinaryLogArgType::UInt64:  return std::vformat(fmt, std::make_format_args(value.u));
+            case BinaryLogArgType::Float:
+            case BinaryLogArgType::Double:  return std::vformat(fmt, std::make_format_args(value.d));
+            case BinaryLogArgType::String:  return std::vformat(fmt, std::make_format_args(value.text));
+            case BinaryLogArgType::Pointer:
+            {
+                const void* pointer = reinterpret_cast<const void*>(static_cast<uintptr_t>(value.u));
+                return std::vformat(fmt, std::make_format_args(pointer));
+            }
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+        return "{?}";
+    }
+
+    // Walks the format string and substitutes each replacement field in turn.
+    static std::string FormatMessage(std::string_view format, const std::vector<Value>& values)
+    {
+        std::string result;
+        size_t nextIndex = 0;
+        for (size_t i = 0; i < format.size(); ++i)
+        {
+            char c = format[i];
+            if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c)
+            {
+                result += c;
+                ++i;
+                continue;
+            }
+            if (c != '{')
+            {
+                result += c;
+                continue;
+            }
+
+            size_t close = format.find('}', i);
+            if (close == std::string_view::npos)
+            {
+                result.append(format.substr(i));
+                break;
+            }
+
+            std::string_view field = format.substr(i + 1, close - i - 1);
+            size_t colon = field.find(':');
+            std::string_view indexText = field.substr(0, colon);
+            std::string_view spec = colon == std::string_view::npos ? std::string_view() : field.substr(colon + 1);
+
+            size_t index = nextIndex++;
+            if (!indexText.empty())
+            {
+                index = 0;
+                for (char digit : indexText)
+                    index = index * 10 + static_cast<size_t>(digit - '0');
+            }
+
+            result += index < values.size() ? FormatValue(values[index], spec) : "{?}";
+            i = close;
+        }
+        return result;
+    }
+};
+
+// Binary counterpart of TRACELOG_AT: registers the format once per call site and
+// writes only its id, a timestamp and the raw arguments. Falls back to text
+// logging while no binary log is open, e.g.
+// TRACELOG_BINARY(ServerLog, LogLevel::LOG_LEVEL_DEBUG, "entity {} at {:.2f}", id, x);
+#define TRACELOG_BINARY(logger, level, format, ...) \
+    do { \
+        if constexpr (TraceLog::IsCompiledIn(level)) \
+        { \
+            if (TraceLog::IsEnabled(level)) \
+            { \
+                if (BinaryLog::IsOpen()) \
+                { \
+                    static const uint32_t binlog_format_id = BinaryLog::RegisterFormat( \
+                        level, logger::Tag(), format, decltype(BinaryLog::Signature(__VA_ARGS__)){}); \
+                    BinaryLog::Write(binlog_format_id __VA_OPT__(,) __VA_ARGS__); \
+                } \
+                else \
+                    TraceLog::Log(level, logger::Tag(), std::string_view(format) __VA_OPT__(,) __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
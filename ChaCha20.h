@@ -0,0 +1,142 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace utils
+{
+    // ChaCha20 keystream generator (RFC 8439 block function) used as a CSPRNG.
+    // State words 12-13 hold a 64-bit block counter and 14-15 a 64-bit nonce, so
+    // one key produces 2^70 bytes before the counter wraps.
+    class ChaCha20
+    {
+    public:
+        static constexpr size_t BlockSize = 64;
+
+        using Key = std::array<uint32_t, 8>;
+        using Nonce = std::array<uint32_t, 2>;
+
+        ChaCha20() = default;
+
+        ChaCha20(const Key& key, const Nonce& nonce, uint64_t counter = 0)
+        {
+            Seed(key, nonce, counter);
+        }
+
+        ChaCha20(const ChaCha20&) = delete;
+        ChaCha20& operator=(const ChaCha20&) = delete;
+
+        ~ChaCha20()
+        {
+            Wipe();
+        }
+
+        void Seed(const Key& key, const Nonce& nonce, uint64_t counter = 0)
+        {
+            m_state[0] = 0x61707865;
+            m_state[1] = 0x3320646e;
+            m_state[2] = 0x79622d32;
+            m_state[3] = 0x6b206574;
+            for (size_t i = 0; i < key.size(); ++i)
+                m_state[4 + i] = key[i];
+            m_state[12] = static_cast<uint32_t>(counter);
+            m_state[13] = static_cast<uint32_t>(counter >> 32);
+            m_state[14] = nonce[0];
+            m_state[15] = nonce[1];
+            m_available = 0;
+        }
+
+        // Writes the next size bytes of keystream.
+        void Fill(void* out, size_t size)
+        {
+            uint8_t* dest = static_cast<uint8_t*>(out);
+
+            // Drain what's left of the buffered block first.
+            const size_t buffered = size < m_available ? size : m_available;
+            if (buffered > 0)
+            {
+                std::memcpy(dest, m_buffer.data() + BlockSize - m_available, buffered);
+                std::memset(m_buffer.data() + BlockSize - m_available, 0, buffered);
+                m_available -= buffered;
+                dest += buffered;
+                size -= buffered;
+            }
+
+            // Whole blocks go straight to the caller.
+            while (size >= BlockSize)
+            {
+                Block(dest);
+                dest += BlockSize;
+                size -= BlockSize;
+            }
+
+            if (size > 0)
+            {
+                Block(m_buffer.data());
+                std::memcpy(dest, m_buffer.data(), size);
+                std::memset(m_buffer.data(), 0, size);
+                m_available = BlockSize - size;
+            }
+        }
+
+        // Clears key material and buffered output.
+        void Wipe()
+        {
+            volatile uint32_t* state = m_state.data();
+            for (size_t i = 0; i < m_state.size(); ++i)
+                state[i] = 0;
+            volatile uint8_t* buffer = m_buffer.data();
+            for (size_t i = 0; i < m_buffer.size(); ++i)
+                buffer[i] = 0;
+            m_available = 0;
+        }
+
+    private:
+        static constexpr uint32_t Rotl(uint32_t value, int shift)
+        {
+            return (value << shift) | (value >> (32 - shift));
+        }
+
+        static void QuarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d)
+        {
+            a += b; d ^= a; d = Rotl(d, 16);
+            c += d; b ^= c; b = Rotl(b, 12);
+            a += b; d ^= a; d = Rotl(d, 8);
+            c += d; b ^= c; b = Rotl(b, 7);
+        }
+
+        // One 64-byte block of keystream, serialized little-endian, then bumps the counter.
+        void Block(uint8_t* out)
+        {
+            std::array<uint32_t, 16> x = m_state;
+            for (int round = 0; round < 10; ++round)
+            {
+                QuarterRound(x[0], x[4], x[8], x[12]);
+                QuarterRound(x[1], x[5], x[9], x[13]);
+                QuarterRound(x[2], x[6], x[10], x[14]);
+                QuarterRound(x[3], x[7], x[11], x[15]);
+                QuarterRound(x[0], x[5], x[10], x[15]);
+                QuarterRound(x[1], x[6], x[11], x[12]);
+                QuarterRound(x[2], x[7], x[8], x[13]);
+                QuarterRound(x[3], x[4], x[9], x[14]);
+            }
+
+            for (size_t i = 0; i < 16; ++i)
+            {
+                const uint32_t word = x[i] + m_state[i];
+                out[i * 4 + 0] = static_cast<uint8_t>(word);
+                out[i * 4 + 1] = static_cast<uint8_t>(word >> 8);
+                out[i * 4 + 2] = static_cast<uint8_t>(word >> 16);
+                out[i * 4 + 3] = static_cast<uint8_t>(word >> 24);
+            }
+
+            if (++m_state[12] == 0)
+                ++m_state[13];
+        }
+
+        std::array<uint32_t, 16> m_state{};
+        std::array<uint8_t, BlockSize> m_buffer{};
+        size_t m_available = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include "TscClock.h"
+
+using namespace std::chrono;
+
+// Hardware clock behind real time. Define GAMEUTILS_USE_TSC_CLOCK to read the CPU
+// timestamp counter instead of steady_clock where now() is hot.
+#if defined(GAMEUTILS_USE_TSC_CLOCK)
+using GameClock = TscClock;
+#else
+using GameClock = steady_clock;
+#endif
+
+// Where a GameTime gets "now" from: monotonic nanoseconds from an arbitrary origin.
+class ClockSource
+{
+public:
+	virtual ~ClockSource() = default;
+	virtual nanoseconds Now() = 0;
+};
+
+// Wall-clock time.
+class RealClock : public ClockSource
+{
+public:
+	nanoseconds Now() override
+	{
+		return duration_cast<nanoseconds>(GameClock::now().time_since_epoch());
+	}
+};
+
+// Real time multiplied by a scale factor: 0.5 for slow motion, 4 for fast forward,
+// 0 to freeze. Changing the scale never makes time jump.
+class ScaledClock : public ClockSource
+{
+public:
+	explicit ScaledClock(double scale = 1.0)
+		: m_scale(scale)
+	{
+		m_anchorReal = m_real.Now();
+	}
+
+	nanoseconds Now() override
+	{
+		const nanoseconds real = m_real.Now() - m_anchorReal;
+		return m_anchorScaled + nanoseconds(static_cast<int64_t>(static_cast<double>(real.count()) * m_scale));
+	}
+
+	void SetScale(double scale)
+	{
+		m_anchorScaled = Now();
+		m_anchorReal = m_real.Now();
+		m_scale = scale < 0.0 ? 0.0 : scale;
+	}
+
+	double GetScale() const { return m_scale; }
+
+private:
+	RealClock m_real;
+	nanoseconds m_anchorReal{ 0 };
+	nanoseconds m_anchorScaled{ 0 };
+	double m_scale;
+};
+
+// Time that only moves when told to, for headless simulation, replays and tests:
+// step it by a fixed frame and call GameTime::Update as fast as the CPU allows.
+class ManualClock : public ClockSource
+{
+public:
+	nanoseconds Now() override
+	{
+		return m_now;
+	}
+
+	template<typename Rep, typename Period>
+	void Advance(duration<Rep, Period> step)
+	{
+		if (step > duration<Rep, Period>::zero())
+			m_now += duration_cast<nanoseconds>(step);
+	}
+
+	// Moves to an absolute time; going backwards is ignored to keep time monotonic.
+	void Set(nanoseconds now)
+	{
+		if (now > m_now)
+			m_now = now;
+	}
+
+private:
+	nanoseconds m_now{ 0 };
+};
\ No newline at end of file
@@ -0,0 +1,496 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "GameTime.h"
+
+// Size-classed free lists for coroutine frames, so spawning scripted sequences
+// doesn't go to malloc once the pool is warm. Lists are per thread; memory is
+// carved from 64 KB chunks and kept for the life of the process. Frames above
+// MaxPooledSize use the global allocator.
+class CoroutineFramePool
+{
+public:
+	static constexpr size_t Granularity = 64;
+	static constexpr size_t MaxPooledSize = 2048;
+	static constexpr size_t ChunkSize = 64 * 1024;
+
+	static void* Allocate(size_t size)
+	{
+		if (size > MaxPooledSize)
+			return ::operator new(size);
+
+		const size_t sizeClass = ClassOf(size);
+		FreeNode*& head = Heads()[sizeClass];
+		if (!head)
+			Refill(head, (sizeClass + 1) * Granularity);
+
+		FreeNode* node = head;
+		head = node->next;
+		return node;
+	}
+
+	static void Free(void* pointer, size_t size)
+	{
+		if (size > MaxPooledSize)
+		{
+			::operator delete(pointer);
+			return;
+		}
+
+		FreeNode*& head = Heads()[ClassOf(size)];
+		FreeNode* node = static_cast<FreeNode*>(pointer);
+		node->next = head;
+		head = node;
+	}
+
+private:
+	struct FreeNode
+	{
+		FreeNode* next;
+	};
+
+	static constexpr size_t ClassCount = MaxPooledSize / Granularity;
+
+	static size_t ClassOf(size_t size)
+	{
+		return size == 0 ? 0 : (size - 1) / Granularity;
+	}
+
+	static std::array<FreeNode*, ClassCount>& Heads()
+	{
+		thread_local std::array<FreeNode*, ClassCount> heads{};
+		return heads;
+	}
+
+	static void Refill(FreeNode*& head, size_t blockSize)
+	{
+		std::byte* chunk = static_cast<std::byte*>(::operator new(ChunkSize));
+		for (size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize)
+		{
+			FreeNode* node = reinterpret_cast<FreeNode*>(chunk + offset);
+			node->next = head;
+			head = node;
+		}
+	}
+};
+
+class CoroutineScheduler;
+
+template<typename T = void>
+class Task;
+
+namespace detail
+{
+	struct TaskPromiseBase
+	{
+		CoroutineScheduler* scheduler = nullptr;
+		uint64_t root = 0;                       // id of the spawned task this frame runs under
+		std::coroutine_handle<> continuation;    // awaiting parent, resumed when this task ends
+		std::exception_ptr exception;
+
+		static void* operator new(size_t size)
+		{
+			return CoroutineFramePool::Allocate(size);
+		}
+
+		static void operator delete(void* pointer, size_t size)
+		{
+			CoroutineFramePool::Free(pointer, size);
+		}
+
+		std::suspend_always initial_suspend() noexcept { return {}; }
+
+		struct FinalAwaiter
+		{
+			bool await_ready() noexcept { return false; }
+
+			template<typename P>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+			{
+				auto continuation = handle.promise().continuation;
+				return continuation ? continuation : std::noop_coroutine();
+			}
+
+			void await_resume() noexcept {}
+		};
+
+		FinalAwaiter final_suspend() noexcept { return {}; }
+
+		void unhandled_exception()
+		{
+			exception = std::current_exception();
+		}
+	};
+
+	template<typename T>
+	struct TaskPromise : TaskPromiseBase
+	{
+		std::optional<T> value;
+
+		Task<T> get_return_object();
+
+		template<typename U>
+		void return_value(U&& result)
+		{
+			value.emplace(std::forward<U>(result));
+		}
+
+		T TakeResult()
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+			return std::move(*value);
+		}
+	};
+
+	template<>
+	struct TaskPromise<void> : TaskPromiseBase
+	{
+		Task<void> get_return_object();
+
+		void return_void() {}
+
+		void TakeResult()
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+	};
+}
+
+// Lazily started coroutine. Spawn it on a CoroutineScheduler, or co_await it from
+// another task to run it as a child and get its result.
+template<typename T>
+class [[nodiscard]] Task
+{
+public:
+	using promise_type = detail::TaskPromise<T>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Task() = default;
+	explicit Task(Handle handle) : m_handle(handle) {}
+
+	Task(Task&& other) noexcept
+		: m_handle(std::exchange(other.m_handle, nullptr))
+	{
+	}
+
+	Task& operator=(Task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_handle)
+				m_handle.destroy();
+			m_handle = std::exchange(other.m_handle, nullptr);
+		}
+		return *this;
+	}
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	~Task()
+	{
+		if (m_handle)
+			m_handle.destroy();
+	}
+
+	bool IsDone() const
+	{
+		return !m_handle || m_handle.done();
+	}
+
+	// Awaiting a task runs it as a child of the awaiting one. Awaiting an empty
+	// (default-constructed or moved-from) task throws std::logic_error.
+	struct Awaiter
+	{
+		Handle child;
+
+		bool await_ready() const noexcept { return !child || child.done(); }
+
+		template<typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> parent) noexcept
+		{
+			detail::TaskPromiseBase& parentPromise = parent.promise();
+			promise_type& childPromise = child.promise();
+			childPromise.scheduler = parentPromise.scheduler;
+			childPromise.root = parentPromise.root;
+			childPromise.continuation = parent;
+			return child;
+		}
+
+		T await_resume()
+		{
+			if (!child)
+				throw std::logic_error("co_await on an empty Task");
+			return child.promise().TakeResult();
+		}
+	};
+
+	Awaiter operator co_await() && noexcept
+	{
+		return Awaiter{ m_handle };
+	}
+
+private:
+	friend class CoroutineScheduler;
+
+	Handle Release()
+	{
+		return std::exchange(m_handle, nullptr);
+	}
+
+	Handle m_handle;
+};
+
+namespace detail
+{
+	template<typename T>
+	Task<T> TaskPromise<T>::get_return_object()
+	{
+		return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+	}
+
+	inline Task<void> TaskPromise<void>::get_return_object()
+	{
+		return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+	}
+}
+
+using TaskId = uint64_t;
+
+// Runs spawned tasks against a GameTime. Call Update once per frame after
+// GameTime::Update: it resumes tasks waiting on NextFrame, then the ones whose
+// Delay has elapsed (through its own TimerCollection). Tasks run on the thread
+// that calls Update.
+class CoroutineScheduler
+{
+public:
+	explicit CoroutineScheduler(GameTime& time = GameTime::Current())
+		: m_timers(time)
+	{
+	}
+
+	CoroutineScheduler(const CoroutineScheduler&) = delete;
+	CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+	// Unfinished tasks are destroyed without being resumed.
+	~CoroutineScheduler()
+	{
+		m_timers.ClearTimers();
+		for (Root& root : m_roots)
+		{
+			if (root.handle)
+				root.handle.destroy();
+		}
+	}
+
+	// Starts the task right away; it runs until its first suspension. An exception escaping
+	// a task ends it: Spawn rethrows one thrown before that first suspension, Update any later
+	// one. Exceptions from other tasks are left for Update, even when Spawn is called from
+	// inside a task.
+	TaskId Spawn(Task<void> task)
+	{
+		auto handle = task.Release();
+		if (!handle)
+			return 0;
+
+		uint32_t index;
+		if (!m_freeRoots.empty())
+		{
+			index = m_freeRoots.back();
+			m_freeRoots.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_roots.size());
+			m_roots.emplace_back();
+		}
+
+		Root& root = m_roots[index];
+		root.handle = handle;
+		const TaskId id = (static_cast<uint64_t>(root.generation) << 32) | index;
+
+		handle.promise().scheduler = this;
+		handle.promise().root = id;
+		++m_running;
+		if (std::exception_ptr exception = Step(id, handle))
+			std::rethrow_exception(exception);
+		return id;
+	}
+
+	// Destroys a task at its current suspension point. Pending wake-ups for it are ignored.
+	// A task that is executing (the caller itself, or one further up the stack that
+	// spawned it) has no suspension point to stop at: Cancel refuses it and returns
+	// false. A task ends itself with co_return.
+	bool Cancel(TaskId id)
+	{
+		if (!IsRunning(id) || m_roots[static_cast<uint32_t>(id)].executing)
+			return false;
+
+		Root& root = m_roots[static_cast<uint32_t>(id)];
+		root.handle.destroy();
+		Retire(root, static_cast<uint32_t>(id));
+		return true;
+	}
+
+	bool IsRunning(TaskId id) const
+	{
+		const uint32_t index = static_cast<uint32_t>(id);
+		return index < m_roots.size() && m_roots[index].handle && m_roots[index].generation == static_cast<uint32_t>(id >> 32);
+	}
+
+	size_t GetTaskCount() const
+	{
+		return m_running;
+	}
+
+	void Update()
+	{
+		m_resuming.swap(m_nextFrame);
+		for (const Waiter& waiter : m_resuming)
+			Resume(waiter.root, waiter.handle);
+		m_resuming.clear();
+
+		m_timers.CheckTimers();
+		RethrowPending();
+	}
+
+	TimerCollection& GetTimers()
+	{
+		return m_timers;
+	}
+
+private:
+	template<typename Rep, typename Period>
+	friend struct DelayAwaiter;
+	friend struct NextFrameAwaiter;
+
+	struct Root
+	{
+		std::coroutine_handle<detail::TaskPromise<void>> handle;
+		uint32_t generation = 1;
+		bool executing = false; // between resume and the next suspension
+	};
+
+	struct Waiter
+	{
+		TaskId root;
+		std::coroutine_handle<> handle;
+	};
+
+	void ResumeNextFrame(TaskId root, std::coroutine_handle<> handle)
+	{
+		m_nextFrame.push_back({ root, handle });
+	}
+
+	void ResumeAfter(TaskId root, std::coroutine_handle<> handle, nanoseconds delay)
+	{
+		m_timers.AddTimer(delay, [this, root, handle] { Resume(root, handle); }, false, TimerCollection::StartMode::StartImmediately);
+	}
+
+	void Resume(TaskId id, std::coroutine_handle<> handle)
+	{
+		std::exception_ptr exception = Step(id, handle);
+		if (exception && !m_pendingException)
+			m_pendingException = exception;
+	}
+
+	// Runs the task to its next suspension. Returns the exception it ended with, if any.
+	std::exception_ptr Step(TaskId id, std::coroutine_handle<> handle)
+	{
+		if (!IsRunning(id))
+			return nullptr;
+
+		m_roots[static_cast<uint32_t>(id)].executing = true;
+		handle.resume();
+
+		// Re-read the root: the task may have spawned others and grown m_roots.
+		Root& root = m_roots[static_cast<uint32_t>(id)];
+		root.executing = false;
+		if (!root.handle.done())
+			return nullptr;
+
+		std::exception_ptr exception = root.handle.promise().exception;
+		root.handle.destroy();
+		Retire(root, static_cast<uint32_t>(id));
+		return exception;
+	}
+
+	// A task's exception is held until the update finishes, so it never unwinds
+	// through the timer collection or skips the other tasks due this frame.
+	void RethrowPending()
+	{
+		if (m_pendingException)
+			std::rethrow_exception(std::exchange(m_pendingException, nullptr));
+	}
+
+	void Retire(Root& root, uint32_t index)
+	{
+		root.handle = nullptr;
+		root.generation++;
+		m_freeRoots.push_back(index);
+		--m_running;
+	}
+
+	TimerCollection m_timers;
+	std::vector<Root> m_roots;
+	std::vector<uint32_t> m_freeRoots;
+	std::vector<Waiter> m_nextFrame;
+	std::vector<Waiter> m_resuming;
+	size_t m_running = 0;
+	std::exception_ptr m_pendingException;
+};
+
+template<typename Rep, typename Period>
+struct DelayAwaiter
+{
+	std::chrono::duration<Rep, Period> delay;
+
+	bool await_ready() const noexcept { return delay <= std::chrono::duration<Rep, Period>::zero(); }
+
+	template<typename P>
+	void await_suspend(std::coroutine_handle<P> handle)
+	{
+		detail::TaskPromiseBase& promise = handle.promise();
+		promise.scheduler->ResumeAfter(promise.root, handle, duration_cast<nanoseconds>(delay));
+	}
+
+	void await_resume() const noexcept {}
+};
+
+struct NextFrameAwaiter
+{
+	bool await_ready() const noexcept { return false; }
+
+	template<typename P>
+	void await_suspend(std::coroutine_handle<P> handle)
+	{
+		detail::TaskPromiseBase& promise = handle.promise();
+		promise.scheduler->ResumeNextFrame(promise.root, handle);
+	}
+
+	void await_resume() const noexcept {}
+};
+
+// co_await Delay(500ms): resumes on the first scheduler update at least that much game time later.
+template<typename Rep, typename Period>
+DelayAwaiter<Rep, Period> Delay(std::chrono::duration<Rep, Period> delay)
+{
+	return { delay };
+}
+
+// co_await NextFrame(): resumes on the next scheduler update.
+inline NextFrameAwaiter NextFrame()
+{
+	return {};
+}
\ No newline at end of file
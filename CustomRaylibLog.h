@@ -3,22 +3,35 @@
 #include <string>
 #include <format>
 #include <cstdarg>
+#include <memory>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "AsyncLogWriter.h"
+#include "FlightRecorder.h"
 namespace raylib {
 #include "raylib/raylib.h"
 }
 
+// Arrays rather than pointers so a color can be used as a template argument
 class ConsoleColor {
 public:
-    static constexpr const char* ResetCode = "\033[0m";
-    static constexpr const char* BoldCode = "\033[1m";
-
-    static constexpr const char* Red = "\033[31m";
-    static constexpr const char* Green = "\033[32m";
-    static constexpr const char* Yellow = "\033[33m";
-    static constexpr const char* Blue = "\033[34m";
-    static constexpr const char* Magenta = "\033[35m";
-    static constexpr const char* Cyan = "\033[36m";
-    static constexpr const char* White = "\033[37m";
+    static constexpr char ResetCode[] = "\033[0m";
+    static constexpr char BoldCode[] = "\033[1m";
+
+    static constexpr char Red[] = "\033[31m";
+    static constexpr char Green[] = "\033[32m";
+    static constexpr char Yellow[] = "\033[33m";
+    static constexpr char Blue[] = "\033[34m";
+    static constexpr char Magenta[] = "\033[35m";
+    static constexpr char Cyan[] = "\033[36m";
+    static constexpr char White[] = "\033[37m";
 };
 
 
@@ -26,7 +39,7 @@ public:
 class Colorizer
 {
 public:
-    static size_t VisibleLength(const std::string& s)
+    static size_t VisibleLength(std::string_view s)
     {
         size_t len = 0;
         for (size_t i = 0; i < s.size();)
@@ -103,6 +116,315 @@ static constexpr LogLevel LOG_LEVEL_2 = LOG_LEVEL_1 | LogLevel::LOG_LEVEL_ERROR;
 static constexpr LogLevel LOG_LEVEL_3 = LOG_LEVEL_2 | LogLevel::LOG_LEVEL_FATAL;
 static constexpr LogLevel LOG_LEVEL_ALL = LogLevel::LOG_LEVEL_DEBUG | LOG_LEVEL_3;
 
+// Calls below this level are compiled out of ServerLog/ClientLog and the TRACELOG_* macros.
+// Define before including to strip e.g. debug logging from release builds.
+#ifndef TRACELOG_MIN_LEVEL
+#define TRACELOG_MIN_LEVEL LogLevel::LOG_LEVEL_DEBUG
+#endif
+
+// The "[LEVEL][TAG]" prefix padded to a fixed visible width. Kept as pieces so
+// runtime tags never need a concatenated string; prebuilt prefixes use only Tag.
+struct LogPrefix
+{
+    static constexpr size_t Width = 18; // adjust to the longest [LEVEL][TAG] length
+
+    std::string_view Level;
+    std::string_view Tag;
+    std::string_view Pad;
+
+    static LogPrefix For(LogLevel level, std::string_view tagStr)
+    {
+        return { LevelText(level), tagStr, Padding(LevelWidth(level) + Colorizer::VisibleLength(tagStr)) };
+    }
+
+    static constexpr LogPrefix Prebuilt(std::string_view prefix)
+    {
+        return { std::string_view(), prefix, std::string_view() };
+    }
+
+    std::string ToString() const
+    {
+        std::string result;
+        result.reserve(Level.size() + Tag.size() + Pad.size());
+        result.append(Level).append(Tag).append(Pad);
+        return result;
+    }
+
+    uint64_t Hash() const
+    {
+        const uint64_t levelHash = std::hash<std::string_view>{}(Level);
+        return levelHash ^ (std::hash<std::string_view>{}(Tag) + 0x9e3779b97f4a7c15ull + (levelHash << 6) + (levelHash >> 2));
+    }
+
+    // Same text as Colorizer::Color("[LEVEL]", color), without building it per line
+    static constexpr std::string_view LevelText(LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::LOG_LEVEL_DEBUG:   return "\033[36m[DEBUG]\033[0m";
+        case LogLevel::LOG_LEVEL_INFO:    return "\033[37m[INFO]\033[0m";
+        case LogLevel::LOG_LEVEL_WARNING: return "\033[33m[WARNING]\033[0m";
+        case LogLevel::LOG_LEVEL_ERROR:   return "\033[35m[ERROR]\033[0m";
+        case LogLevel::LOG_LEVEL_FATAL:   return "\033[31m[FATAL]\033[0m";
+        default:                          return "";
+        }
+    }
+
+    static constexpr size_t LevelWidth(LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::LOG_LEVEL_DEBUG:   return 7;
+        case LogLevel::LOG_LEVEL_INFO:    return 6;
+        case LogLevel::LOG_LEVEL_WARNING: return 9;
+        case LogLevel::LOG_LEVEL_ERROR:   return 7;
+        case LogLevel::LOG_LEVEL_FATAL:   return 7;
+        default:                          return 0;
+        }
+    }
+
+    static constexpr std::string_view Padding(size_t visibleLen)
+    {
+        constexpr std::string_view spaces = "                  ";
+        static_assert(spaces.size() == Width);
+        return visibleLen < Width ? spaces.substr(0, Width - visibleLen) : std::string_view();
+    }
+};
+
+struct LogRateLimit
+{
+    double MessagesPerSecond = 0.0; // 0 disables limiting for the level
+    double Burst = 10.0;            // messages let through back to back before limiting starts
+};
+
+// Token bucket per tag+format key. Sharded so unrelated call sites rarely contend;
+// every shard keeps its own copy of the per-level limits, read under its lock.
+class LogRateLimiter
+{
+public:
+    static constexpr size_t LevelCount = 5;
+
+    static size_t LevelIndex(LogLevel level)
+    {
+        return static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(level)));
+    }
+
+    void SetLimits(const std::array<LogRateLimit, LevelCount>& limits)
+    {
+        for (Shard& shard : m_shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.limits = limits;
+        }
+    }
+
+    // Returns false if the message should be dropped. When a message is let through after
+    // some were dropped, suppressed receives how many were dropped in between.
+    bool Admit(LogLevel level, uint64_t key, const LogPrefix& prefix, uint64_t& suppressed)
+    {
+        const size_t index = LevelIndex(level);
+        if (index >= LevelCount)
+            return true;
+
+        const auto now = std::chrono::steady_clock::now();
+        Shard& shard = m_shards[key % ShardCount];
+        std::lock_guard lock(shard.mutex);
+
+        const LogRateLimit& limit = shard.limits[index];
+        if (limit.MessagesPerSecond <= 0.0)
+            return true; // limit removed since the caller checked
+
+        if (shard.buckets.size() >= MaxBucketsPerShard && shard.buckets.find(key) == shard.buckets.end())
+            PruneIdle(shard, now);
+
+        auto [it, inserted] = shard.buckets.try_emplace(key);
+        Bucket& bucket = it->second;
+        if (inserted)
+        {
+            bucket.tokens = limit.Burst;
+            bucket.level = level;
+            bucket.prefix = prefix.ToString();
+        }
+        else
+        {
+            const double elapsed = std::chrono::duration<double>(now - bucket.last).count();
+            bucket.tokens = std::min(limit.Burst, bucket.tokens + elapsed * limit.MessagesPerSecond);
+        }
+        bucket.last = now;
+
+        if (bucket.tokens < 1.0)
+        {
+            ++bucket.suppressed;
+            return false;
+        }
+
+        bucket.tokens -= 1.0;
+        suppressed = bucket.suppressed;
+        bucket.suppressed = 0;
+        return true;
+    }
+
+    // Calls report(level, prefix, count) for every key with dropped messages not yet reported.
+    // Counts are taken under each shard's lock and reported after it is released, so report
+    // may log (and come back through Admit) freely.
+    template<typename F>
+    void DrainSuppressed(F&& report)
+    {
+        struct Pending
+        {
+            LogLevel level;
+            std::string prefix;
+            uint64_t count;
+        };
+
+        std::vector<Pending> pending;
+        for (Shard& shard : m_shards)
+        {
+            {
+                std::lock_guard lock(shard.mutex);
+                for (auto& [key, bucket] : shard.buckets)
+                {
+                    if (bucket.suppressed > 0)
+                    {
+                        pending.push_back({ bucket.level, bucket.prefix, bucket.suppressed });
+                        bucket.suppressed = 0;
+                    }
+                }
+            }
+
+            for (const Pending& entry : pending)
+                report(entry.level, std::string_view(entry.prefix), entry.count);
+            pending.clear();
+        }
+    }
+
+    void Clear()
+    {
+        for (Shard& shard : m_shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.buckets.clear();
+        }
+    }
+
+private:
+    static constexpr size_t ShardCount = 16;
+    static constexpr size_t MaxBucketsPerShard = 1024;
+
+    struct Bucket
+    {
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point last{};
+        uint64_t suppressed = 0;
+        LogLevel level = LogLevel::LOG_LEVEL_NONE;
+        std::string prefix;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::array<LogRateLimit, LevelCount> limits{};
+        std::unordered_map<uint64_t, Bucket> buckets;
+    };
+
+    // Forgets keys that have nothing pending and have refilled to a full burst, so
+    // one-off messages can't grow the table forever. A bucket that is still throttling
+    // is kept, otherwise pruning would hand it a fresh burst.
+    static void PruneIdle(Shard& shard, std::chrono::steady_clock::time_point now)
+    {
+        for (auto it = shard.buckets.begin(); it != shard.buckets.end();)
+        {
+            if (it->second.suppressed == 0 && IsFull(it->second, shard.limits[LevelIndex(it->second.level)], now))
+                it = shard.buckets.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    static bool IsFull(const Bucket& bucket, const LogRateLimit& limit, std::chrono::steady_clock::time_point now)
+    {
+        if (limit.MessagesPerSecond <= 0.0)
+            return true;
+        const double elapsed = std::chrono::duration<double>(now - bucket.last).count();
+        return bucket.tokens + elapsed * limit.MessagesPerSecond >= limit.Burst;
+    }
+
+    std::array<Shard, ShardCount> m_shards;
+};
+
+// Owning pointer that logging threads read without a lock. A reader pins the object
+// for one call through Ref; Reset() publishes the replacement and destroys the old
+// object once every Ref that could have seen it is gone. Refs count themselves under
+// one of two epochs, and Reset() flips the epoch and waits only for the old one, so
+// threads that keep logging can't hold it off forever. Every step is seq_cst: a Ref
+// that registers in the new epoch is guaranteed to read the new pointer.
+// Reset() calls must not race each other.
+template<typename T>
+class PinnedPtr
+{
+public:
+    class Ref
+    {
+    public:
+        explicit Ref(const PinnedPtr& owner)
+            : m_owner(owner)
+        {
+            for (;;)
+            {
+                m_epoch = m_owner.m_epoch.load(std::memory_order_seq_cst);
+                m_owner.m_inFlight[m_epoch].fetch_add(1, std::memory_order_seq_cst);
+                if (m_owner.m_epoch.load(std::memory_order_seq_cst) == m_epoch)
+                    break;
+                m_owner.m_inFlight[m_epoch].fetch_sub(1, std::memory_order_release);
+            }
+            m_value = m_owner.m_active.load(std::memory_order_seq_cst);
+        }
+
+        ~Ref()
+        {
+            m_owner.m_inFlight[m_epoch].fetch_sub(1, std::memory_order_release);
+        }
+
+        Ref(const Ref&) = delete;
+        Ref& operator=(const Ref&) = delete;
+
+        explicit operator bool() const { return m_value != nullptr; }
+        T* operator->() const { return m_value; }
+
+    private:
+        const PinnedPtr& m_owner;
+        T* m_value;
+        uint32_t m_epoch;
+    };
+
+    PinnedPtr() = default;
+    PinnedPtr(const PinnedPtr&) = delete;
+    PinnedPtr& operator=(const PinnedPtr&) = delete;
+
+    void Reset(std::unique_ptr<T> value = nullptr)
+    {
+        std::unique_ptr<T> previous = std::exchange(m_owned, std::move(value));
+        m_active.store(m_owned.get(), std::memory_order_seq_cst);
+
+        const uint32_t old = m_epoch.load(std::memory_order_relaxed);
+        m_epoch.store(old ^ 1, std::memory_order_seq_cst);
+        while (m_inFlight[old].load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+        previous.reset();
+    }
+
+    bool IsSet() const
+    {
+        return m_active.load(std::memory_order_acquire) != nullptr;
+    }
+
+private:
+    std::unique_ptr<T> m_owned;
+    std::atomic<T*> m_active{ nullptr };
+    std::atomic<uint32_t> m_epoch{ 0 };
+    mutable std::array<std::atomic<uint32_t>, 2> m_inFlight{};
+};
+
 // TraceLog stays as a utility class
 class TraceLog
 {
@@ -115,6 +437,121 @@ private:
     }
 
     LogLevel current_log_level = LOG_LEVEL_3;
+    std::mutex sink_mutex; // serializes enabling and disabling the writer and recorder
+    PinnedPtr<AsyncLogWriter> async_writer; // unset while logging synchronously
+    PinnedPtr<FlightRecorder> flight_recorder; // optional crash-safe copy of every line
+
+    // Storm suppression, both off by default. The hot path reads only the atomics;
+    // the limits themselves live in the limiter's shards and are read under their locks.
+    std::mutex rate_limit_mutex; // serializes SetRateLimit
+    std::array<LogRateLimit, LogRateLimiter::LevelCount> rate_limits{};
+    std::atomic<uint32_t> rate_limited_levels{ 0 }; // LogLevel bits with a limit set
+    LogRateLimiter rate_limiter;
+
+    std::mutex duplicate_mutex;
+    std::atomic<bool> collapse_duplicates{ false };
+    std::chrono::steady_clock::duration duplicate_summary_interval = std::chrono::seconds(1);
+    uint64_t last_line_hash = 0;
+    LogLevel last_line_level = LogLevel::LOG_LEVEL_NONE;
+    std::string last_line_prefix;
+    std::string last_line_message;
+    uint64_t repeat_count = 0;
+    std::chrono::steady_clock::time_point repeat_since{};
+
+    bool IsRateLimited(LogLevel level) const
+    {
+        return (rate_limited_levels.load(std::memory_order_acquire) & static_cast<uint32_t>(level)) != 0;
+    }
+
+    // The hash is only a quick reject; the text is compared so a collision is never
+    // counted as a repeat.
+    bool IsLastLine(LogLevel level, const LogPrefix& prefix, std::string_view message, uint64_t hash) const
+    {
+        if (hash != last_line_hash || level != last_line_level || message != last_line_message)
+            return false;
+        const std::string_view last = last_line_prefix;
+        return last.size() == prefix.Level.size() + prefix.Tag.size() + prefix.Pad.size()
+            && last.starts_with(prefix.Level)
+            && last.substr(prefix.Level.size()).starts_with(prefix.Tag)
+            && last.ends_with(prefix.Pad);
+    }
+
+    static uint64_t HashKey(const LogPrefix& prefix, std::string_view text)
+    {
+        const uint64_t prefixHash = prefix.Hash();
+        return prefixHash ^ (std::hash<std::string_view>{}(text) + 0x9e3779b97f4a7c15ull + (prefixHash << 6) + (prefixHash >> 2));
+    }
+
+    // Token bucket check keyed on prefix + format (or message for unformatted calls)
+    bool AdmitRate(LogLevel level, const LogPrefix& prefix, std::string_view keyText)
+    {
+        uint64_t suppressed = 0;
+        if (!rate_limiter.Admit(level, HashKey(prefix, keyText), prefix, suppressed))
+            return false;
+        if (suppressed > 0)
+            WriteSummary(prefix, suppressed);
+        return true;
+    }
+
+    void Emit(LogLevel level, const LogPrefix& prefix, std::string_view message)
+    {
+        EmitLine(level, prefix, message);
+        if (level != LogLevel::LOG_LEVEL_FATAL)
+            return;
+        if (PinnedPtr<FlightRecorder>::Ref recorder(flight_recorder); recorder)
+            recorder->Sync();
+    }
+
+    void EmitLine(LogLevel level, const LogPrefix& prefix, std::string_view message)
+    {
+        if (!collapse_duplicates.load(std::memory_order_relaxed))
+        {
+            WriteLine(prefix, message);
+            return;
+        }
+
+        const uint64_t hash = HashKey(prefix, message);
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock(duplicate_mutex);
+        if (IsLastLine(level, prefix, message, hash))
+        {
+            ++repeat_count;
+            if (now - repeat_since >= duplicate_summary_interval)
+            {
+                WriteSummary(prefix, repeat_count);
+                repeat_count = 0;
+                repeat_since = now;
+            }
+            return;
+        }
+
+        if (repeat_count > 0)
+            WriteSummary(LogPrefix::Prebuilt(last_line_prefix), repeat_count);
+        last_line_hash = hash;
+        last_line_level = level;
+        last_line_prefix.assign(prefix.Level).append(prefix.Tag).append(prefix.Pad);
+        last_line_message.assign(message);
+        repeat_count = 0;
+        repeat_since = now;
+        WriteLine(prefix, message);
+    }
+
+    void WriteSummary(const LogPrefix& prefix, uint64_t count)
+    {
+        WriteLine(prefix, std::format("suppressed {} similar messages", count));
+    }
+
+    // Writes the prefix pieces and message separately so no line is ever concatenated.
+    void WriteLine(const LogPrefix& prefix, std::string_view message)
+    {
+        if (PinnedPtr<FlightRecorder>::Ref recorder(flight_recorder); recorder)
+            recorder->Write({ prefix.Level, prefix.Tag, prefix.Pad, message });
+
+        if (PinnedPtr<AsyncLogWriter>::Ref writer(async_writer); writer)
+            writer->Enqueue({ prefix.Level, prefix.Tag, prefix.Pad, message, "\n" });
+        else
+            std::cout << prefix.Level << prefix.Tag << prefix.Pad << message << std::endl;
+    }
 
 public:
     static constexpr LogLevel MapRaylibLogLevel(int raylibLevel)
@@ -133,19 +570,34 @@ public:
 
     static inline void HookRaylibLog()
     {
-		raylib::SetTraceLogCallback([](int logLevel, const char* text, va_list args) {
-            va_list argsCopy;
-            va_copy(argsCopy, args);
-            int len = std::vsnprintf(nullptr, 0, text, argsCopy);
-            va_end(argsCopy);
+		raylib::SetTraceLogCallback(&RaylibLogCallback);
+    }
+
+    // The callback HookRaylibLog installs; public so it can be driven without raylib.
+    static void RaylibLogCallback(int logLevel, const char* text, va_list args)
+    {
+        const LogLevel level = MapRaylibLogLevel(logLevel);
+        if (!IsEnabled(level))
+            return;
 
-            if (len < 0) return; // formatting error
+        // Format once into a per-thread buffer; only oversized messages touch the heap
+        thread_local char buffer[1024];
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        int len = std::vsnprintf(buffer, sizeof(buffer), text, argsCopy);
+        va_end(argsCopy);
 
-            std::string message(len, '\0');
-            std::vsnprintf(message.data(), message.size() + 1, text, args);
+        if (len < 0) return; // formatting error
 
-            Log(MapRaylibLogLevel(logLevel), "[RAYLIB]", message);
-			});
+        if (static_cast<size_t>(len) < sizeof(buffer))
+        {
+            LogRaw(level, "[RAYLIB]", std::string_view(buffer, static_cast<size_t>(len)));
+            return;
+        }
+
+        std::string message(len, '\0');
+        std::vsnprintf(message.data(), message.size() + 1, text, args);
+        LogRaw(level, "[RAYLIB]", message);
     }
 
     static void SetLogLevel(LogLevel level)
@@ -153,110 +605,321 @@ public:
         GetInstance().current_log_level = level;
     }
 
-    static void Log(LogLevel level, const std::string& tagStr, const std::string& message)
+    static constexpr bool IsCompiledIn(LogLevel level)
     {
-        if (!hasFlag(GetInstance().current_log_level, level))
+        return static_cast<uint32_t>(level) >= static_cast<uint32_t>(TRACELOG_MIN_LEVEL);
+    }
+
+    // Cheap check to run before any formatting work
+    static bool IsEnabled(LogLevel level)
+    {
+        return IsCompiledIn(level) && hasFlag(GetInstance().current_log_level, level);
+    }
+
+    // Moves output to a background writer thread. Safe while other threads log;
+    // lines they write during the switch may come out of order.
+    static void EnableAsync(const AsyncLogOptions& options = {})
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.sink_mutex);
+        if (instance.async_writer.IsSet())
             return;
+        std::cout.flush();
+        instance.async_writer.Reset(std::make_unique<AsyncLogWriter>(options));
+    }
 
-        std::string prefix;
-        switch (level)
+    // Drains the queue and returns to synchronous output. Safe while other threads
+    // log: it waits for lines being queued right now before stopping the writer.
+    static void DisableAsync()
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.sink_mutex);
+        instance.async_writer.Reset();
+    }
+
+    static bool IsAsync()
+    {
+        return GetInstance().async_writer.IsSet();
+    }
+
+    // Blocks until everything logged so far has reached the output.
+    static void Flush()
+    {
+        if (PinnedPtr<AsyncLogWriter>::Ref writer(GetInstance().async_writer); writer)
+            writer->Flush();
+        else
+            std::cout.flush();
+    }
+
+    static uint64_t GetDroppedCount()
+    {
+        PinnedPtr<AsyncLogWriter>::Ref writer(GetInstance().async_writer);
+        return writer ? writer->GetDroppedCount() : 0;
+    }
+
+    // Mirrors every line into a memory-mapped ring of about sizeBytes that survives a crash.
+    // Read it back with FlightRecorder::ReadRecords. Safe while other threads log;
+    // an already enabled recorder is replaced once lines writing to it finish.
+    static bool EnableFlightRecorder(const std::string& path, size_t sizeBytes = 8 * 1024 * 1024)
+    {
+        auto recorder = FlightRecorder::Open(path, sizeBytes);
+        if (!recorder)
+            return false;
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.sink_mutex);
+        instance.flight_recorder.Reset(std::move(recorder));
+        return true;
+    }
+
+    // Waits for lines being recorded right now before closing the file.
+    static void DisableFlightRecorder()
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.sink_mutex);
+        instance.flight_recorder.Reset();
+    }
+
+    // Colored "[LEVEL][TAG]" prefix padded to a fixed visible width
+    static std::string FormatPrefix(LogLevel level, std::string_view tagStr)
+    {
+        return LogPrefix::For(level, tagStr).ToString();
+    }
+
+    // Limits every level set in levels to a token bucket per tag+format.
+    // A zero MessagesPerSecond removes the limit.
+    static void SetRateLimit(LogLevel levels, LogRateLimit limit)
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.rate_limit_mutex);
+        uint32_t limited = 0;
+        for (size_t i = 0; i < instance.rate_limits.size(); ++i)
         {
-        case LogLevel::LOG_LEVEL_DEBUG:   prefix = Colorizer::Color("[DEBUG]", ConsoleColor::Cyan); break;
-        case LogLevel::LOG_LEVEL_INFO:    prefix = Colorizer::Color("[INFO]", ConsoleColor::White); break;
-        case LogLevel::LOG_LEVEL_WARNING: prefix = Colorizer::Color("[WARNING]", ConsoleColor::Yellow); break;
-        case LogLevel::LOG_LEVEL_ERROR:   prefix = Colorizer::Color("[ERROR]", ConsoleColor::Magenta); break;
-        case LogLevel::LOG_LEVEL_FATAL:   prefix = Colorizer::Color("[FATAL]", ConsoleColor::Red); break;
+            if (hasFlag(levels, static_cast<LogLevel>(1u << i)))
+                instance.rate_limits[i] = limit;
+            if (instance.rate_limits[i].MessagesPerSecond > 0.0)
+                limited |= 1u << i;
         }
 
-        const int totalWidth = 18; // adjust to the longest [LEVEL][TAG] length
+        // Limits reach the shards before callers are sent there.
+        instance.rate_limiter.SetLimits(instance.rate_limits);
+        instance.rate_limited_levels.store(limited, std::memory_order_release);
+        if (limited == 0)
+            instance.rate_limiter.Clear();
+    }
 
-        std::string combined = prefix + tagStr;
-        size_t visibleLen = Colorizer::VisibleLength(combined);
+    // Collapses consecutive identical lines, printing a summary at most once per interval.
+    // Repeats counted so far are summarized before the setting changes.
+    static void SetDuplicateCollapsing(bool enabled, std::chrono::milliseconds summaryInterval = std::chrono::seconds(1))
+    {
+        auto& instance = GetInstance();
+        std::lock_guard lock(instance.duplicate_mutex);
+        if (instance.repeat_count > 0)
+            instance.WriteSummary(LogPrefix::Prebuilt(instance.last_line_prefix), instance.repeat_count);
+        instance.collapse_duplicates.store(enabled, std::memory_order_relaxed);
+        instance.duplicate_summary_interval = summaryInterval;
+        instance.last_line_hash = 0;
+        instance.last_line_level = LogLevel::LOG_LEVEL_NONE;
+        instance.last_line_message.clear();
+        instance.repeat_count = 0;
+    }
 
-        std::string padded = combined + std::string((visibleLen < totalWidth) ? totalWidth - visibleLen : 0, ' ');
+    // Prints pending "suppressed N similar messages" summaries. Call periodically,
+    // e.g. once a second, so a storm that stopped still gets reported.
+    static void ReportSuppressed()
+    {
+        auto& instance = GetInstance();
+        if (instance.rate_limited_levels.load(std::memory_order_acquire) != 0)
+        {
+            instance.rate_limiter.DrainSuppressed([&instance](LogLevel, std::string_view prefix, uint64_t count) {
+                instance.WriteSummary(LogPrefix::Prebuilt(prefix), count);
+                });
+        }
 
-        std::cout << padded << message << std::endl;
+        std::lock_guard lock(instance.duplicate_mutex);
+        if (instance.repeat_count > 0)
+        {
+            instance.WriteSummary(LogPrefix::Prebuilt(instance.last_line_prefix), instance.repeat_count);
+            instance.repeat_count = 0;
+            instance.repeat_since = std::chrono::steady_clock::now();
+        }
     }
 
-    template<typename... Args>
-    static void Log(LogLevel level, const std::string& tagStr, std::string_view format, Args&&... args)
+    static void Log(LogLevel level, const std::string& tagStr, const std::string& message)
     {
-        std::string message = std::vformat(format, std::make_format_args(args...));
-        Log(level, tagStr, message);
+        LogRaw(level, tagStr, message);
     }
-};
 
-/// Define specialized tag loggers
-class ServerLog
-{
-private:
-    static constexpr const char* tag_name = "[SERVER]";
-    static constexpr const char* tag_color = ConsoleColor::Blue;
-public:
-    template<typename... Args>
-    static void Debug(std::string_view format, Args&&... args)
+    // Logs already formatted text without any intermediate strings
+    static void LogRaw(LogLevel level, std::string_view tagStr, std::string_view message)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_DEBUG, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        if (!hasFlag(GetInstance().current_log_level, level))
+            return;
+        LogPrefixed(level, LogPrefix::For(level, tagStr), message);
     }
 
-    template<typename... Args>
-    static void Info(std::string_view format, Args&&... args)
+    static void LogPrefixed(LogLevel level, const LogPrefix& prefix, std::string_view message)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_INFO, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        auto& instance = GetInstance();
+        if (!hasFlag(instance.current_log_level, level))
+            return;
+        if (instance.IsRateLimited(level) && !instance.AdmitRate(level, prefix, message))
+            return;
+
+        instance.Emit(level, prefix, message);
     }
 
     template<typename... Args>
-    static void Warning(std::string_view format, Args&&... args)
+    static void Log(LogLevel level, std::string_view tagStr, std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_WARNING, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        if (!IsEnabled(level))
+            return;
+
+        LogFormatted(level, LogPrefix::For(level, tagStr), format, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
-    static void Error(std::string_view format, Args&&... args)
+    static void LogFormatted(LogLevel level, const LogPrefix& prefix, std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_ERROR, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        if (!IsEnabled(level))
+            return;
+
+        auto& instance = GetInstance();
+        if (instance.IsRateLimited(level) && !instance.AdmitRate(level, prefix, format))
+            return;
+
+        std::string message = std::vformat(format, std::make_format_args(args...));
+        instance.Emit(level, prefix, message);
     }
+};
 
-    template<typename... Args>
-    static void Fatal(std::string_view format, Args&&... args)
+// String literal usable as a template argument, e.g. TagLogger<"NET", ConsoleColor::Blue>
+template<size_t N>
+struct FixedString
+{
+    char data[N]{};
+
+    constexpr FixedString(const char (&str)[N])
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_FATAL, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        for (size_t i = 0; i < N; ++i)
+            data[i] = str[i];
     }
+
+    constexpr size_t size() const { return N - 1; }
+    constexpr std::string_view view() const { return { data, N - 1 }; }
 };
 
-class ClientLog
+/// Tag logger whose colored, padded prefix for every level is built at compile time.
+/// A new subsystem tag is one line: using NetLog = TagLogger<"NET", ConsoleColor::Blue>;
+template<FixedString Name, const char* Color = ConsoleColor::White>
+class TagLogger
 {
 private:
-    static constexpr const char* tag_name = "[CLIENT]";
-    static constexpr const char* tag_color = ConsoleColor::Blue;
+    template<size_t N>
+    static constexpr void Append(std::array<char, N>& out, size_t& pos, std::string_view text)
+    {
+        for (char c : text)
+            out[pos++] = c;
+    }
+
+    static constexpr size_t tag_width = Name.size() + 2; // "[NAME]"
+    static constexpr size_t tag_length = std::string_view(Color).size() + tag_width + std::string_view(ConsoleColor::ResetCode).size();
+
+    static constexpr std::array<char, tag_length> tag_text = [] {
+        std::array<char, tag_length> out{};
+        size_t pos = 0;
+        Append(out, pos, Color);
+        Append(out, pos, "[");
+        Append(out, pos, Name.view());
+        Append(out, pos, "]");
+        Append(out, pos, ConsoleColor::ResetCode);
+        return out;
+        }();
+
+    template<LogLevel Level>
+    static constexpr size_t prefix_length = LogPrefix::LevelText(Level).size() + tag_length
+        + LogPrefix::Padding(LogPrefix::LevelWidth(Level) + tag_width).size();
+
+    template<LogLevel Level>
+    static constexpr std::array<char, prefix_length<Level>> prefix_text = [] {
+        std::array<char, prefix_length<Level>> out{};
+        size_t pos = 0;
+        Append(out, pos, LogPrefix::LevelText(Level));
+        Append(out, pos, std::string_view(tag_text.data(), tag_length));
+        Append(out, pos, LogPrefix::Padding(LogPrefix::LevelWidth(Level) + tag_width));
+        return out;
+        }();
+
+    template<LogLevel Level, typename... Args>
+    static void Write(std::string_view format, Args&&... args)
+    {
+        if constexpr (TraceLog::IsCompiledIn(Level))
+        {
+            if (TraceLog::IsEnabled(Level))
+                TraceLog::LogFormatted(Level, Prefix<Level>(), format, std::forward<Args>(args)...);
+        }
+    }
+
 public:
+    // Colored "[NAME]", what Colorizer::Color(tag_name, tag_color) used to build per call
+    static constexpr std::string_view Tag()
+    {
+        return { tag_text.data(), tag_text.size() };
+    }
+
+    template<LogLevel Level>
+    static constexpr LogPrefix Prefix()
+    {
+        return LogPrefix::Prebuilt({ prefix_text<Level>.data(), prefix_text<Level>.size() });
+    }
+
     template<typename... Args>
     static void Debug(std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_DEBUG, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        Write<LogLevel::LOG_LEVEL_DEBUG>(format, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     static void Info(std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_INFO, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        Write<LogLevel::LOG_LEVEL_INFO>(format, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     static void Warning(std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_WARNING, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        Write<LogLevel::LOG_LEVEL_WARNING>(format, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     static void Error(std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_ERROR, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        Write<LogLevel::LOG_LEVEL_ERROR>(format, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     static void Fatal(std::string_view format, Args&&... args)
     {
-        TraceLog::Log(LogLevel::LOG_LEVEL_FATAL, Colorizer::Color(tag_name, tag_color), std::string_view(format), std::forward<Args>(args)...);
+        Write<LogLevel::LOG_LEVEL_FATAL>(format, std::forward<Args>(args)...);
     }
-};
\ No newline at end of file
+};
+
+/// Define specialized tag loggers
+using ServerLog = TagLogger<"SERVER", ConsoleColor::Blue>;
+using ClientLog = TagLogger<"CLIENT", ConsoleColor::Blue>;
+
+// Level-checked logging that skips argument evaluation entirely when the level is
+// compiled out or disabled at runtime, e.g. TRACELOG_DEBUG(ServerLog, "pos {}", Expensive());
+#define TRACELOG_AT(logger, level, method, ...) \
+    do { \
+        if constexpr (TraceLog::IsCompiledIn(level)) \
+        { \
+            if (TraceLog::IsEnabled(level)) \
+                logger::method(__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define TRACELOG_DEBUG(logger, ...)   TRACELOG_AT(logger, LogLevel::LOG_LEVEL_DEBUG, Debug, __VA_ARGS__)
+#define TRACELOG_INFO(logger, ...)    TRACELOG_AT(logger, LogLevel::LOG_LEVEL_INFO, Info, __VA_ARGS__)
+#define TRACELOG_WARNING(logger, ...) TRACELOG_AT(logger, LogLevel::LOG_LEVEL_WARNING, Warning, __VA_ARGS__)
+#define TRACELOG_ERROR(logger, ...)   TRACELOG_AT(logger, LogLevel::LOG_LEVEL_ERROR, Error, __VA_ARGS__)
+#define TRACELOG_FATAL(logger, ...)   TRACELOG_AT(logger, LogLevel::LOG_LEVEL_FATAL, Fatal, __VA_ARGS__)
\ No newline at end of file
@@ -0,0 +1,233 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GameTime.h"
+
+// A simulation that advances in fixed steps at its own rate, e.g. 60 Hz physics.
+// Frame time is accumulated in integer nanoseconds so the tick rate never drifts.
+class TickDomain
+{
+public:
+	std::function<void(const TickDomain&)> OnTick; // Called once per fixed step
+
+public:
+	explicit TickDomain(std::string name, double hz, uint32_t maxCatchUpTicks = 5)
+		: m_name(std::move(name)), m_maxCatchUpTicks(std::max<uint32_t>(1, maxCatchUpTicks))
+	{
+		SetRate(hz);
+	}
+
+	// Runs every step that fits in the accumulated time. Returns the number of ticks run.
+	uint32_t Advance(nanoseconds delta)
+	{
+		Accumulate(delta);
+
+		uint32_t ticks = 0;
+		while (IsTickDue())
+		{
+			Tick();
+			++ticks;
+		}
+		return ticks;
+	}
+
+	// Rates outside [MinRate, MaxRate] throw, as do zero, negative and non-finite ones.
+	// MinRate is just above 1e9 / INT64_MAX, the slowest rate whose step fits in nanoseconds.
+	static constexpr double MinRate = 1.1e-10;         // one tick every ~290 years
+	static constexpr double MaxRate = 1'000'000'000.0; // one tick per nanosecond
+
+	void SetRate(double hz)
+	{
+		if (!std::isfinite(hz) || hz <= 0.0)
+			throw std::invalid_argument("Tick rate must be positive and finite");
+		if (hz < MinRate || hz > MaxRate)
+			throw std::out_of_range("Tick rate is outside [MinRate, MaxRate]");
+
+		m_step = nanoseconds(std::max<int64_t>(1, static_cast<int64_t>(1'000'000'000.0 / hz + 0.5)));
+		m_accumulator = std::min(m_accumulator, m_step - nanoseconds(1));
+	}
+
+	// Upper bound on ticks per update; time beyond it is dropped instead of
+	// building up a backlog the simulation can never work off.
+	void SetMaxCatchUp(uint32_t ticks)
+	{
+		m_maxCatchUpTicks = std::max<uint32_t>(1, ticks);
+	}
+
+	void Reset()
+	{
+		m_accumulator = nanoseconds(0);
+		m_droppedTime = nanoseconds(0);
+		m_tickCount = 0;
+	}
+
+	void Pause() { m_paused = true; }
+	void Resume() { m_paused = false; }
+	bool IsPaused() const { return m_paused; }
+
+	// Fraction of a step left in the accumulator, for interpolating between the last two states.
+	float Alpha() const
+	{
+		return static_cast<float>(static_cast<double>(m_accumulator.count()) / static_cast<double>(m_step.count()));
+	}
+
+	template<typename DurationType = std::chrono::duration<float>>
+	DurationType GetStep() const
+	{
+		return std::chrono::duration_cast<DurationType>(m_step);
+	}
+
+	// Simulated time: number of ticks run times the step.
+	template<typename DurationType = std::chrono::duration<float>>
+	DurationType GetSimulationTime() const
+	{
+		return std::chrono::duration_cast<DurationType>(m_step * m_tickCount);
+	}
+
+	double GetRate() const { return 1'000'000'000.0 / static_cast<double>(m_step.count()); }
+	uint64_t GetTickCount() const { return m_tickCount; }
+	uint32_t GetMaxCatchUp() const { return m_maxCatchUpTicks; }
+	nanoseconds GetDroppedTime() const { return m_droppedTime; }
+	const std::string& GetName() const { return m_name; }
+
+private:
+	friend class FixedTimestep;
+
+	void Accumulate(nanoseconds delta)
+	{
+		if (m_paused || delta <= nanoseconds(0))
+			return;
+
+		// Clamp so the accumulator never holds more than the catch-up budget, and with
+		// very long steps never more than nanoseconds can represent.
+		const nanoseconds room = nanoseconds::max() - m_accumulator;
+		const bool budgetOverflows = m_maxCatchUpTicks > room.count() / m_step.count();
+		const nanoseconds budget = budgetOverflows ? room : m_step * m_maxCatchUpTicks;
+		if (delta > budget)
+		{
+			m_droppedTime += delta - budget;
+			delta = budget;
+		}
+		m_accumulator += delta;
+	}
+
+	bool IsTickDue() const
+	{
+		return m_accumulator >= m_step;
+	}
+
+	// How long ago, relative to the end of the frame, the next due tick should have run.
+	nanoseconds Overdue() const
+	{
+		return m_accumulator - m_step;
+	}
+
+	void Tick()
+	{
+		m_accumulator -= m_step;
+		++m_tickCount;
+		if (OnTick)
+			OnTick(*this);
+	}
+
+	std::string m_name;
+	nanoseconds m_step{ 1 };
+	nanoseconds m_accumulator{ 0 };
+	nanoseconds m_droppedTime{ 0 };
+	uint32_t m_maxCatchUpTicks;
+	uint64_t m_tickCount = 0;
+	bool m_paused = false;
+	bool m_removed = false; // removed during FixedTimestep::Update, erased once it finishes
+};
+
+// Drives several tick domains from GameTime's frame delta. Within one update the
+// ticks of all domains run in simulated-time order, so a 20 Hz net tick that falls
+// between two 60 Hz physics ticks sees the first one and not the second.
+class FixedTimestep
+{
+public:
+	TickDomain& AddDomain(std::string name, double hz, uint32_t maxCatchUpTicks = 5)
+	{
+		m_domains.push_back(std::make_unique<TickDomain>(std::move(name), hz, maxCatchUpTicks));
+		return *m_domains.back();
+	}
+
+	TickDomain* GetDomain(std::string_view name)
+	{
+		for (auto& domain : m_domains)
+		{
+			if (!domain->m_removed && domain->GetName() == name)
+				return domain.get();
+		}
+		return nullptr;
+	}
+
+	// Safe to call from an OnTick callback: the domain stops ticking at once and is
+	// destroyed when the update finishes.
+	void RemoveDomain(std::string_view name)
+	{
+		for (auto& domain : m_domains)
+		{
+			if (domain->GetName() == name)
+				domain->m_removed = true;
+		}
+		if (!m_updating)
+			EraseRemoved();
+	}
+
+	// Call once per frame after GameTime::Update. Returns the number of ticks run.
+	uint32_t Update()
+	{
+		return Update(GameTime::GetDeltaTime<nanoseconds>());
+	}
+
+	// Steps with the frame delta of a specific clock, e.g. a manually stepped simulation.
+	uint32_t Update(const GameTime& time)
+	{
+		return Update(time.Delta<nanoseconds>());
+	}
+
+	uint32_t Update(nanoseconds delta)
+	{
+		for (auto& domain : m_domains)
+			domain->Accumulate(delta);
+
+		m_updating = true;
+		uint32_t ticks = 0;
+		for (;;)
+		{
+			// The most overdue tick runs first; ties go to the domain added first.
+			TickDomain* next = nullptr;
+			for (auto& domain : m_domains)
+			{
+				if (!domain->m_removed && domain->IsTickDue() && (!next || domain->Overdue() > next->Overdue()))
+					next = domain.get();
+			}
+			if (!next)
+				break;
+
+			next->Tick();
+			++ticks;
+		}
+		m_updating = false;
+		EraseRemoved();
+		return ticks;
+	}
+
+private:
+	void EraseRemoved()
+	{
+		std::erase_if(m_domains, [](const std::unique_ptr<TickDomain>& d) { return d->m_removed; });
+	}
+
+	std::vector<std::unique_ptr<TickDomain>> m_domains;
+	bool m_updating = false;
+};
\ No newline at end of file
@@ -0,0 +1,303 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+// Keep windows.h from renaming or clashing with raylib symbols (DrawText, Rectangle, CloseWindow...)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef NOGDI
+#define NOGDI
+#endif
+#ifndef NOUSER
+#define NOUSER
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Crash-safe circular log in a memory-mapped file. Records are plain stores into
+// shared pages, so the last N MB survive the process dying without any syscall per
+// message. Lines are split over fixed-size slots stamped with a global sequence;
+// ReadRecords() puts them back in order and drops anything torn mid-write.
+class FlightRecorder
+{
+public:
+    static constexpr char Magic[8] = { 'G', 'U', 'F', 'L', 'T', 'R', 'E', 'C' };
+    static constexpr uint32_t Version = 1;
+    static constexpr size_t SlotSize = 256;
+
+    // Opens or creates the file. An existing recording with the same geometry is
+    // continued so a restart doesn't wipe what the previous run left behind.
+    static std::unique_ptr<FlightRecorder> Open(const std::string& path, size_t sizeBytes)
+    {
+        const uint64_t slotCount = std::max<uint64_t>(16, sizeBytes / SlotSize);
+        const size_t fileSize = sizeof(Header) + slotCount * SlotSize;
+
+        std::unique_ptr<FlightRecorder> recorder(new FlightRecorder());
+        if (!recorder->Map(path, fileSize))
+            return nullptr;
+
+        Header* header = recorder->GetHeader();
+        const bool compatible = std::memcmp(header->magic, Magic, sizeof(Magic)) == 0
+            && header->version == Version && header->slotSize == SlotSize && header->slotCount == slotCount;
+        if (!compatible)
+        {
+            std::memset(recorder->m_base, 0, fileSize);
+            std::memcpy(header->magic, Magic, sizeof(Magic));
+            header->version = Version;
+            header->slotSize = SlotSize;
+            header->slotCount = slotCount;
+            header->nextSequence = 0;
+        }
+
+        recorder->m_slotCount = slotCount;
+        return recorder;
+    }
+
+    ~FlightRecorder()
+    {
+        Unmap();
+    }
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Stores the concatenation of parts as one record. Safe to call from any thread.
+    void Write(std::initializer_list<std::string_view> parts)
+    {
+        size_t total = 0;
+        for (auto part : parts)
+            total += part.size();
+
+        uint64_t slotsNeeded = std::max<uint64_t>(1, (total + TextCapacity - 1) / TextCapacity);
+        if (slotsNeeded > m_slotCount)
+        {
+            slotsNeeded = m_slotCount;
+            total = m_slotCount * TextCapacity;
+        }
+
+        const uint64_t first = std::atomic_ref<uint64_t>(GetHeader()->nextSequence).fetch_add(slotsNeeded, std::memory_order_relaxed);
+
+        auto part = parts.begin();
+        size_t partOffset = 0;
+        size_t remaining = total;
+        for (uint64_t i = 0; i < slotsNeeded; ++i)
+        {
+            Slot& slot = GetSlot(first + i);
+            std::atomic_ref<uint64_t> stamp(slot.stamp);
+            stamp.store(0, std::memory_order_relaxed); // torn until the final stamp below
+            std::atomic_thread_fence(std::memory_order_release);
+
+            const size_t chunk = std::min(remaining, TextCapacity);
+            size_t written = 0;
+            while (written < chunk)
+            {
+                const size_t n = std::min(chunk - written, part->size() - partOffset);
+                std::memcpy(slot.text + written, part->data() + partOffset, n);
+                written += n;
+                partOffset += n;
+                if (partOffset == part->size())
+                {
+                    ++part;
+                    partOffset = 0;
+                }
+            }
+            remaining -= chunk;
+
+            slot.length = static_cast<uint16_t>(chunk);
+            slot.flags = static_cast<uint16_t>((i == 0 ? FlagStart : 0) | (i + 1 < slotsNeeded ? FlagContinued : 0));
+            stamp.store(first + i + 1, std::memory_order_release);
+        }
+    }
+
+    // Forces the mapped pages to disk, for when the OS itself might go down next.
+    void Sync()
+    {
+#if defined(_WIN32)
+        FlushViewOfFile(m_base, 0);
+        FlushFileBuffers(m_file);
+#else
+        ::msync(m_base, m_size, MS_SYNC);
+#endif
+    }
+
+    size_t Capacity() const
+    {
+        return static_cast<size_t>(m_slotCount * TextCapacity);
+    }
+
+    // Extracts complete records, oldest first. Usable on a file left behind by a crash.
+    static std::vector<std::string> ReadRecords(const std::string& path)
+    {
+        std::vector<std::string> records;
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return records;
+
+        Header header{};
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version || header.slotSize != SlotSize)
+            return records;
+
+        std::vector<Slot> slots(static_cast<size_t>(header.slotCount));
+        in.read(reinterpret_cast<char*>(slots.data()), static_cast<std::streamsize>(slots.size() * sizeof(Slot)));
+        slots.resize(static_cast<size_t>(in.gcount()) / sizeof(Slot));
+
+        std::vector<const Slot*> ordered;
+        for (const Slot& slot : slots)
+        {
+            if (slot.stamp != 0 && slot.length <= TextCapacity)
+                ordered.push_back(&slot);
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const Slot* a, const Slot* b) { return a->stamp < b->stamp; });
+
+        std::string current;
+        bool inRecord = false;
+        uint64_t expected = 0;
+        for (const Slot* slot : ordered)
+        {
+            if (slot->flags & FlagStart)
+            {
+                current.assign(slot->text, slot->length);
+                inRecord = true;
+            }
+            else if (inRecord && slot->stamp == expected)
+                current.append(slot->text, slot->length);
+            else
+            {
+                inRecord = false; // head of this record was overwritten
+                continue;
+            }
+
+            expected = slot->stamp + 1;
+            if (!(slot->flags & FlagContinued))
+            {
+                records.push_back(std::move(current));
+                current.clear();
+                inRecord = false;
+            }
+        }
+        return records;
+    }
+
+private:
+    static constexpr uint16_t FlagStart = 1 << 0;
+    static constexpr uint16_t FlagContinued = 1 << 1;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t slotSize;
+        uint64_t slotCount;
+        alignas(8) uint64_t nextSequence; // only accessed through atomic_ref
+        uint8_t reserved[32];
+    };
+
+    struct Slot
+    {
+        uint64_t stamp;  // sequence + 1 once complete, 0 while empty or being written
+        uint16_t length;
+        uint16_t flags;
+        uint32_t reserved;
+        char text[SlotSize - 16];
+    };
+
+    static constexpr size_t TextCapacity = sizeof(Slot::text);
+    static_assert(sizeof(Header) == 64, "FlightRecorder header layout changed.");
+    static_assert(sizeof(Slot) == SlotSize, "FlightRecorder slot layout changed.");
+
+    FlightRecorder() = default;
+
+    Header* GetHeader() const { return reinterpret_cast<Header*>(m_base); }
+
+    Slot& GetSlot(uint64_t sequence) const
+    {
+        return reinterpret_cast<Slot*>(m_base + sizeof(Header))[sequence % m_slotCount];
+    }
+
+#if defined(_WIN32)
+    bool Map(const std::string& path, size_t size)
+    {
+        m_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+            return false;
+
+        const ULARGE_INTEGER fileSize{ .QuadPart = size };
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READWRITE, fileSize.HighPart, fileSize.LowPart, nullptr);
+        if (!m_mapping)
+            return false;
+
+        m_base = static_cast<char*>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+        m_size = size;
+        return m_base != nullptr;
+    }
+
+    void Unmap()
+    {
+        if (m_base)
+            UnmapViewOfFile(m_base);
+        if (m_mapping)
+            CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+        m_base = nullptr;
+    }
+
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    bool Map(const std::string& path, size_t size)
+    {
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (m_fd < 0)
+            return false;
+
+        struct stat info {};
+        if (::fstat(m_fd, &info) != 0)
+            return false;
+        if (static_cast<size_t>(info.st_size) != size && ::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+            return false;
+
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (base == MAP_FAILED)
+            return false;
+
+        m_base = static_cast<char*>(base);
+        m_size = size;
+        return true;
+    }
+
+    void Unmap()
+    {
+        if (m_base)
+            ::munmap(m_base, m_size);
+        if (m_fd >= 0)
+            ::close(m_fd);
+        m_base = nullptr;
+    }
+
+    int m_fd = -1;
+#endif
+
+    char* m_base = nullptr;
+    size_t m_size = 0;
+    uint64_t m_slotCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "LatencyHistogram.h"
+
+using namespace std::chrono;
+
+// Percentiles over the most recent frames of one rolling window.
+struct FrameWindowStats
+{
+	size_t Frames = 0;
+	nanoseconds Mean{ 0 };
+	nanoseconds P50{ 0 };
+	nanoseconds P95{ 0 };
+	nanoseconds P99{ 0 };
+	nanoseconds Max{ 0 };
+	uint64_t Hitches = 0;	// frames in the window above the hitch threshold
+};
+
+// Frame-time statistics fed by GameTime::Update. Keeps a lifetime histogram plus one
+// histogram per rolling window; the oldest frame is subtracted as each new one comes
+// in, so recording is constant time and memory stays fixed after construction.
+class FrameStats
+{
+public:
+	explicit FrameStats(std::initializer_list<size_t> windowFrames = { 60, 600 }, nanoseconds hitchThreshold = 50ms)
+		: m_hitchThreshold(hitchThreshold)
+	{
+		SetWindows(windowFrames);
+	}
+
+	// Replaces the rolling windows (sizes in frames) and clears their history.
+	void SetWindows(std::initializer_list<size_t> windowFrames)
+	{
+		m_windows.clear();
+		size_t longest = 1;
+		for (size_t frames : windowFrames)
+		{
+			m_windows.emplace_back();
+			m_windows.back().Size = std::max<size_t>(1, frames);
+			longest = std::max(longest, m_windows.back().Size);
+		}
+
+		m_history.assign(longest, 0);
+		m_recorded = 0;
+	}
+
+	void Record(nanoseconds frameTime)
+	{
+		const uint64_t value = static_cast<uint64_t>(std::max<int64_t>(0, frameTime.count()));
+		const bool hitch = frameTime > m_hitchThreshold;
+
+		m_lifetime.Record(value);
+		if (hitch)
+			m_hitchCount++;
+
+		for (Window& window : m_windows)
+		{
+			if (m_recorded >= window.Size)
+			{
+				const uint64_t evicted = m_history[(m_recorded - window.Size) % m_history.size()];
+				window.Histogram.Remove(evicted);
+				if (evicted > static_cast<uint64_t>(m_hitchThreshold.count()))
+					window.Hitches--;
+			}
+
+			window.Histogram.Record(value);
+			if (hitch)
+				window.Hitches++;
+		}
+
+		m_history[m_recorded % m_history.size()] = value;
+		m_recorded++;
+	}
+
+	size_t GetWindowCount() const
+	{
+		return m_windows.size();
+	}
+
+	FrameWindowStats GetWindow(size_t index) const
+	{
+		const Window& window = m_windows.at(index);
+		const utils::LatencyHistogram& histogram = window.Histogram;
+
+		FrameWindowStats stats;
+		stats.Frames = static_cast<size_t>(histogram.Count());
+		stats.Mean = nanoseconds(static_cast<int64_t>(histogram.Mean()));
+		stats.P50 = nanoseconds(histogram.Percentile(50.0));
+		stats.P95 = nanoseconds(histogram.Percentile(95.0));
+		stats.P99 = nanoseconds(histogram.Percentile(99.0));
+		stats.Max = nanoseconds(histogram.Percentile(100.0));
+		stats.Hitches = window.Hitches;
+		return stats;
+	}
+
+	// Every frame since start or the last Reset.
+	const utils::LatencyHistogram& GetLifetime() const
+	{
+		return m_lifetime;
+	}
+
+	uint64_t GetHitchCount() const
+	{
+		return m_hitchCount;
+	}
+
+	nanoseconds GetHitchThreshold() const
+	{
+		return m_hitchThreshold;
+	}
+
+	// Restarts the statistics so every counter uses the new threshold.
+	void SetHitchThreshold(nanoseconds threshold)
+	{
+		Reset();
+		m_hitchThreshold = threshold;
+	}
+
+	void Reset()
+	{
+		for (Window& window : m_windows)
+		{
+			window.Histogram.Reset();
+			window.Hitches = 0;
+		}
+		m_lifetime.Reset();
+		m_hitchCount = 0;
+		m_recorded = 0;
+	}
+
+private:
+	struct Window
+	{
+		size_t Size = 0;
+		uint64_t Hitches = 0;
+		utils::LatencyHistogram Histogram;
+	};
+
+	std::vector<Window> m_windows;
+	std::vector<uint64_t> m_history; // ring of the longest window's frame times
+	uint64_t m_recorded = 0;
+
+	utils::LatencyHistogram m_lifetime;
+	nanoseconds m_hitchThreshold;
+	uint64_t m_hitchCount = 0;
+};
\ No newline at end of file
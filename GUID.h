@@ -1,29 +1,111 @@
 #pragma once
 #include <array>
+#include <chrono>
+#include <compare>
 #include <string>
+#include <string_view>
 #include <cstdint>
-#include <sstream>
-#include <iomanip>
+#include <cstring>
 #include <algorithm>
 #include <random>
+#include <span>
 #include <stdexcept>
+#include "ChaCha20.h"
 
 namespace utils
 {
+    namespace detail
+    {
+        // "00" through "ff", two chars per byte value.
+        inline constexpr std::array<char, 512> HexPairs = [] {
+            constexpr char digits[] = "0123456789abcdef";
+            std::array<char, 512> pairs{};
+            for (size_t i = 0; i < 256; ++i)
+            {
+                pairs[i * 2] = digits[i >> 4];
+                pairs[i * 2 + 1] = digits[i & 0xF];
+            }
+            return pairs;
+        }();
+
+        // Nibble value of a hex digit (either case), 0xFF for anything else.
+        inline constexpr std::array<uint8_t, 256> HexValues = [] {
+            std::array<uint8_t, 256> values{};
+            values.fill(0xFF);
+            for (uint8_t i = 0; i < 10; ++i)
+                values['0' + i] = i;
+            for (uint8_t i = 0; i < 6; ++i)
+            {
+                values['a' + i] = static_cast<uint8_t>(10 + i);
+                values['A' + i] = static_cast<uint8_t>(10 + i);
+            }
+            return values;
+        }();
+    }
+
     class GUID
     {
     public:
+        // The nil GUID (all zeros). Use Generate for a random one.
+        GUID() = default;
+
         static GUID Generate()
         {
             GUID guid;
             FillSecureRandom(reinterpret_cast<uint8_t*>(&guid), sizeof(GUID));
-            // Set version (4)
-            guid.Data3 = (guid.Data3 & 0x0FFF) | 0x4000;
-            // Set variant (10xxxxxx)
-            guid.Data4[0] = (guid.Data4[0] & 0x3F) | 0x80;
+            guid.SetVersion4();
+            return guid;
+        }
+
+        // Fills a whole array with random GUIDs in one pass over the generator.
+        static void Generate(std::span<GUID> guids)
+        {
+            FillSecureRandom(reinterpret_cast<uint8_t*>(guids.data()), guids.size_bytes());
+            for (GUID& guid : guids)
+                guid.SetVersion4();
+        }
+
+        // Time-ordered UUIDv7: 48-bit Unix milliseconds, then a 26-bit counter, then random
+        // bits. Successive values from one thread always compare greater, even within one
+        // millisecond, so they make append-friendly keys for indexes and logs.
+        static GUID GenerateV7()
+        {
+            GUID guid;
+            FillSecureRandom(reinterpret_cast<uint8_t*>(&guid), sizeof(GUID));
+            guid.SetVersion7();
+            return guid;
+        }
+
+        static void GenerateV7(std::span<GUID> guids)
+        {
+            FillSecureRandom(reinterpret_cast<uint8_t*>(guids.data()), guids.size_bytes());
+            for (GUID& guid : guids)
+                guid.SetVersion7();
+        }
+
+        // Smallest v7 GUID at a point in time, e.g. the lower bound of a time range scan.
+        static GUID MinForTime(std::chrono::system_clock::time_point time)
+        {
+            GUID guid;
+            guid.SetTimestamp(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count()));
+            guid.Data3 = 0x7000;
+            guid.Data4[0] = 0x80;
             return guid;
         }
 
+        // Version nibble: 4 for Generate, 7 for GenerateV7, 0 for the nil GUID.
+        int GetVersion() const
+        {
+            return Data3 >> 12;
+        }
+
+        // Creation time embedded in a v7 GUID, to millisecond precision. Meaningless for other versions.
+        std::chrono::system_clock::time_point GetTimestamp() const
+        {
+            const uint64_t ms = (static_cast<uint64_t>(Data1) << 16) | Data2;
+            return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+        }
+
         bool operator==(const GUID& other) const
         {
             return Data1 == other.Data1 &&
@@ -32,22 +114,113 @@ namespace utils
                 std::equal(Data4.begin(), Data4.end(), other.Data4.begin());
         }
 
+        // Orders by the canonical text form, which for v7 GUIDs is creation order.
+        std::strong_ordering operator<=>(const GUID& other) const
+        {
+            if (Data1 != other.Data1)
+                return Data1 <=> other.Data1;
+            if (Data2 != other.Data2)
+                return Data2 <=> other.Data2;
+            if (Data3 != other.Data3)
+                return Data3 <=> other.Data3;
+            return Data4 <=> other.Data4;
+        }
+
+        // Fold of the two 64-bit halves. Random bits make that enough on its own; the
+        // multiply spreads GUIDs whose entropy sits in one half (e.g. time-ordered ones).
+        size_t Hash() const
+        {
+            uint64_t halves[2];
+            std::memcpy(halves, this, sizeof(halves));
+            const uint64_t folded = (halves[0] ^ halves[1]) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(folded ^ (folded >> 32));
+        }
+
+        // Length of the canonical form, xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx.
+        static constexpr size_t StringLength = 36;
+
+        // Writes the canonical lowercase form (no terminator). Returns out + StringLength.
+        char* ToChars(char* out) const
+        {
+            const std::array<uint8_t, 16> bytes = ToTextBytes();
+            for (size_t i = 0; i < bytes.size(); ++i)
+            {
+                if (HasDashBefore(i))
+                    *out++ = '-';
+                out[0] = detail::HexPairs[bytes[i] * 2];
+                out[1] = detail::HexPairs[bytes[i] * 2 + 1];
+                out += 2;
+            }
+            return out;
+        }
+
+        // Writes every GUID followed by separator, guids.size() * (StringLength + 1) chars in all.
+        static char* ToChars(std::span<const GUID> guids, char* out, char separator = '\n')
+        {
+            for (const GUID& guid : guids)
+            {
+                out = guid.ToChars(out);
+                *out++ = separator;
+            }
+            return out;
+        }
+
         std::string ToString() const
         {
-            std::ostringstream ss;
-            ss << std::hex << std::setfill('0') << std::nouppercase
-                << std::setw(8) << Data1 << "-"
-                << std::setw(4) << Data2 << "-"
-                << std::setw(4) << Data3 << "-"
-                << std::setw(2) << static_cast<int>(Data4[0])
-                << std::setw(2) << static_cast<int>(Data4[1]) << "-"
-                << std::setw(2) << static_cast<int>(Data4[2])
-                << std::setw(2) << static_cast<int>(Data4[3])
-                << std::setw(2) << static_cast<int>(Data4[4])
-                << std::setw(2) << static_cast<int>(Data4[5])
-                << std::setw(2) << static_cast<int>(Data4[6])
-                << std::setw(2) << static_cast<int>(Data4[7]);
-            return ss.str();
+            std::string result(StringLength, '\0');
+            ToChars(result.data());
+            return result;
+        }
+
+        // Accepts the canonical form in either case, optionally wrapped in braces.
+        static bool TryParse(std::string_view text, GUID& result)
+        {
+            if (text.size() == StringLength + 2 && text.front() == '{' && text.back() == '}')
+                text = text.substr(1, StringLength);
+            if (text.size() != StringLength)
+                return false;
+
+            std::array<uint8_t, 16> bytes;
+            size_t pos = 0;
+            for (size_t i = 0; i < bytes.size(); ++i)
+            {
+                if (HasDashBefore(i) && text[pos++] != '-')
+                    return false;
+
+                const uint8_t high = detail::HexValues[static_cast<uint8_t>(text[pos])];
+                const uint8_t low = detail::HexValues[static_cast<uint8_t>(text[pos + 1])];
+                if ((high | low) > 0xF)
+                    return false;
+                bytes[i] = static_cast<uint8_t>((high << 4) | low);
+                pos += 2;
+            }
+
+            result = FromTextBytes(bytes);
+            return true;
+        }
+
+        // Parses separator-delimited GUIDs into out, e.g. one per line. Returns how many were
+        // parsed; stops at the first malformed entry or when out is full.
+        static size_t TryParse(std::string_view text, std::span<GUID> out, char separator = '\n')
+        {
+            size_t count = 0;
+            while (count < out.size() && !text.empty())
+            {
+                const size_t end = text.find(separator);
+                if (!TryParse(text.substr(0, end), out[count]))
+                    break;
+                ++count;
+                text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+            }
+            return count;
+        }
+
+        static GUID Parse(std::string_view text)
+        {
+            GUID guid;
+            if (!TryParse(text, guid))
+                throw std::invalid_argument("Invalid GUID string");
+            return guid;
         }
 
         uint32_t ToUInt32() const
@@ -81,13 +254,123 @@ namespace utils
         }
 
     private:
-        GUID() = default;
+        // Bytes a thread's generator produces before it rekeys from random_device.
+        static constexpr size_t ReseedInterval = 1 << 20;
+
+        struct SecureGenerator
+        {
+            ChaCha20 rng;
+            size_t bytesUntilReseed = 0;
+
+            void Reseed()
+            {
+                std::random_device rd;
+                ChaCha20::Key key;
+                ChaCha20::Nonce nonce;
+                for (uint32_t& word : key)
+                    word = rd();
+                for (uint32_t& word : nonce)
+                    word = rd();
+                rng.Seed(key, nonce);
+                std::fill(key.begin(), key.end(), 0u);
+                bytesUntilReseed = ReseedInterval;
+            }
+        };
 
+        // random_device can be a syscall per call, so it only seeds a per-thread ChaCha20 stream.
         static void FillSecureRandom(uint8_t* buffer, size_t size)
         {
-            std::random_device rd;
-            for (size_t i = 0; i < size; ++i)
-                buffer[i] = static_cast<uint8_t>(rd());
+            thread_local SecureGenerator generator;
+            while (size > 0)
+            {
+                if (generator.bytesUntilReseed == 0)
+                    generator.Reseed();
+
+                const size_t count = std::min(size, generator.bytesUntilReseed);
+                generator.rng.Fill(buffer, count);
+                generator.bytesUntilReseed -= count;
+                buffer += count;
+                size -= count;
+            }
+        }
+
+        static constexpr bool HasDashBefore(size_t textByte)
+        {
+            return textByte == 4 || textByte == 6 || textByte == 8 || textByte == 10;
+        }
+
+        // The 16 bytes in the order they are written as text: Data1, Data2 and Data3
+        // most significant byte first, then Data4 as stored.
+        std::array<uint8_t, 16> ToTextBytes() const
+        {
+            std::array<uint8_t, 16> bytes;
+            for (size_t i = 0; i < 4; ++i)
+                bytes[i] = static_cast<uint8_t>(Data1 >> (24 - 8 * i));
+            bytes[4] = static_cast<uint8_t>(Data2 >> 8);
+            bytes[5] = static_cast<uint8_t>(Data2);
+            bytes[6] = static_cast<uint8_t>(Data3 >> 8);
+            bytes[7] = static_cast<uint8_t>(Data3);
+            std::copy(Data4.begin(), Data4.end(), bytes.begin() + 8);
+            return bytes;
+        }
+
+        static GUID FromTextBytes(const std::array<uint8_t, 16>& bytes)
+        {
+            GUID guid;
+            guid.Data1 = (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) | (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+            guid.Data2 = static_cast<uint16_t>((bytes[4] << 8) | bytes[5]);
+            guid.Data3 = static_cast<uint16_t>((bytes[6] << 8) | bytes[7]);
+            std::copy(bytes.begin() + 8, bytes.end(), guid.Data4.begin());
+            return guid;
+        }
+
+        void SetTimestamp(uint64_t unixMs)
+        {
+            Data1 = static_cast<uint32_t>(unixMs >> 16);
+            Data2 = static_cast<uint16_t>(unixMs);
+        }
+
+        // Overwrites the timestamp and counter of an already random GUID. The counter is
+        // 26 bits (rand_a plus the top 14 bits of rand_b, RFC 9562 method 1); it starts at
+        // a random value below 2^25 each millisecond and counts up. Should it run out, the
+        // timestamp moves a millisecond ahead so ordering still holds.
+        void SetVersion7()
+        {
+            struct Sequence
+            {
+                uint64_t lastMs = 0;
+                uint32_t counter = 0;
+            };
+            thread_local Sequence sequence;
+
+            const uint32_t seed = (static_cast<uint32_t>(Data3 & 0x7FF) << 14) | (static_cast<uint32_t>(Data4[0] & 0x3F) << 8) | Data4[1];
+            const uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+            if (nowMs > sequence.lastMs)
+            {
+                sequence.lastMs = nowMs;
+                sequence.counter = seed;
+            }
+            else if (++sequence.counter > 0x3FFFFFF)
+            {
+                ++sequence.lastMs;
+                sequence.counter = seed;
+            }
+
+            SetTimestamp(sequence.lastMs);
+            // Version (7) over the counter's high 12 bits
+            Data3 = static_cast<uint16_t>(0x7000 | (sequence.counter >> 14));
+            // Variant (10xxxxxx) over the next 6, then the low 8
+            Data4[0] = static_cast<uint8_t>(0x80 | ((sequence.counter >> 8) & 0x3F));
+            Data4[1] = static_cast<uint8_t>(sequence.counter);
+        }
+
+        void SetVersion4()
+        {
+            // Set version (4)
+            Data3 = (Data3 & 0x0FFF) | 0x4000;
+            // Set variant (10xxxxxx)
+            Data4[0] = (Data4[0] & 0x3F) | 0x80;
         }
 
         uint32_t Data1{};
@@ -95,6 +378,8 @@ namespace utils
         uint16_t Data3{};
         std::array<uint8_t, 8> Data4{};
     };
+
+    static_assert(sizeof(GUID) == 16, "GUID must be tightly packed for bulk generation");
 }
 
 namespace std
@@ -104,7 +389,7 @@ namespace std
     {
         size_t operator()(const utils::GUID& guid) const noexcept
         {
-            return std::hash<std::string>{}(guid.ToString());
+            return guid.Hash();
         }
     };
 }
\ No newline at end of file
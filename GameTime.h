@@ -7,61 +7,171 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "FrameStats.h"
+#include "InlineFunction.h"
+#include "RingBuffer.h"
+#include "TimingWheel.h"
+#include "ClockSource.h"
+
+#if defined(GAMEUTILS_ENABLE_PROFILER)
+#include "Profiler.h"
+#endif
 
 using namespace std::chrono_literals;
 using namespace std::chrono;
 
+// Frame clock. GetInstance() is the process-wide real-time clock; further instances
+// can run on their own ClockSource (scaled, manual) so several simulations can step
+// independently in one process. The static getters read the calling thread's
+// current instance, which is GetInstance() unless a GameTime::Scope says otherwise.
+// All times are kept as integer nanoseconds since start, so they neither drift nor
+// lose precision with uptime; the templated getters convert on the way out.
 class GameTime
 {
-private:
-	GameTime()
+public:
+	explicit GameTime(std::unique_ptr<ClockSource> clock = std::make_unique<RealClock>())
+		: m_clock(std::move(clock))
 	{
-		m_startTime = high_resolution_clock::now();
+		m_startTime = m_clock->Now();
 		m_lastTime = m_startTime;
 	}
-public:
+
+	GameTime(const GameTime&) = delete;
+	GameTime& operator=(const GameTime&) = delete;
+
 	static GameTime& GetInstance()
 	{
 		static GameTime instance;
 		return instance;
 	}
 
+	// The instance the static getters use on this thread.
+	static GameTime& Current()
+	{
+		GameTime* current = CurrentSlot();
+		return current ? *current : GetInstance();
+	}
+
+	// Makes time the calling thread's current instance until the scope ends.
+	class Scope
+	{
+	public:
+		explicit Scope(GameTime& time)
+			: m_previous(CurrentSlot())
+		{
+			CurrentSlot() = &time;
+		}
+
+		~Scope()
+		{
+			CurrentSlot() = m_previous;
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		GameTime* m_previous;
+	};
+
 	void Update()
 	{
-		auto currentTime = high_resolution_clock::now();
+		auto currentTime = m_clock->Now();
 		m_deltaTime = currentTime - m_lastTime;
+		m_totalTime = currentTime - m_startTime;
+		m_frameStats.Record(m_deltaTime);
 		m_lastTime = currentTime;
 		// Update game logic with deltaTime if needed
+
+#if defined(GAMEUTILS_ENABLE_PROFILER)
+		if (this == &GetInstance())
+			Profiler::MarkFrame();
+#endif
+	}
+
+	// Swaps the clock source without a jump in total time.
+	void SetClock(std::unique_ptr<ClockSource> clock)
+	{
+		m_clock = std::move(clock);
+		m_lastTime = m_clock->Now();
+		m_startTime = m_lastTime - m_totalTime;
+	}
+
+	ClockSource& Clock()
+	{
+		return *m_clock;
+	}
+
+	template<typename DurationType = std::chrono::duration<float>>
+	DurationType Delta() const {
+		return std::chrono::duration_cast<DurationType>(m_deltaTime);
+	}
+
+	template<typename DurationType = std::chrono::duration<float>>
+	DurationType Total() const {
+		return std::chrono::duration_cast<DurationType>(m_totalTime);
+	}
+
+	template<typename DurationType = std::chrono::duration<float>>
+	DurationType Elapsed() const {
+		return std::chrono::duration_cast<DurationType>(m_clock->Now() - m_startTime);
+	}
+
+	FrameStats& Stats()
+	{
+		return m_frameStats;
 	}
 
 	template<typename DurationType = std::chrono::duration<float>>
 	static inline DurationType GetDeltaTime() {
-		return std::chrono::duration_cast<DurationType>(GetInstance().m_deltaTime);
+		return Current().Delta<DurationType>();
 	}
 
 	template<typename DurationType = std::chrono::duration<float>>
 	static inline DurationType GetTotalTime() {
-		return std::chrono::duration_cast<DurationType>(GetInstance().m_lastTime - GetInstance().m_startTime);
+		return Current().Total<DurationType>();
 	}
 
 	template<typename DurationType = std::chrono::duration<float>>
 	static inline DurationType GetElapsedTime() {
-		return std::chrono::duration_cast<DurationType>(high_resolution_clock::now() - GetInstance().m_startTime);
+		return Current().Elapsed<DurationType>();
 	}
 
+	// Frame-time percentiles and hitch counts, recorded on every Update.
+	static FrameStats& GetFrameStats()
+	{
+		return Current().m_frameStats;
+	}
+
+	// Compared in integer nanoseconds whatever DurationType is.
 	template<typename DurationType = std::chrono::duration<float>>
 	static inline bool HasElapsed(DurationType initial, DurationType duration)
 	{
-		return GetTotalTime<DurationType>() - initial >= duration;
+		return Current().m_totalTime - duration_cast<nanoseconds>(initial) >= duration_cast<nanoseconds>(duration);
 	}
 
 private:
-	high_resolution_clock::time_point m_startTime;
-	high_resolution_clock::time_point m_lastTime;
+	static GameTime*& CurrentSlot()
+	{
+		thread_local GameTime* current = nullptr;
+		return current;
+	}
+
+	std::unique_ptr<ClockSource> m_clock;
+	nanoseconds m_startTime{ 0 };
+	nanoseconds m_lastTime{ 0 };
 
-	duration<float> m_deltaTime{ 0.0f };
+	nanoseconds m_deltaTime{ 0 };
+	nanoseconds m_totalTime{ 0 };
+	FrameStats m_frameStats;
 };
 
+// Standalone timer measured against the calling thread's current GameTime.
 class GameTimer
 {
 public:
@@ -92,8 +202,8 @@ public:
 public:
 	template<typename Rep, typename Period>
 	explicit GameTimer(duration<Rep, Period> dur, bool repeatTimer = false)
-		: m_startTime(GameTime::GetTotalTime<duration<float>>()),
-		m_duration(duration_cast<duration<float>>(dur)),
+		: m_startTime(GameTime::GetTotalTime<nanoseconds>()),
+		m_duration(duration_cast<nanoseconds>(dur)),
 		m_repeat(repeatTimer)
 	{
 	}
@@ -102,7 +212,7 @@ public:
 	{
 		if (!m_active)
 		{
-			m_startTime = GameTime::GetTotalTime<duration<float>>();
+			m_startTime = GameTime::GetTotalTime<nanoseconds>();
 			m_active = true;
 		}
 	}
@@ -138,12 +248,12 @@ public:
 		if (!m_active)
 			return false;
 
-		if (GameTime::HasElapsed(m_startTime, m_duration)) {
+		if (GameTime::GetTotalTime<nanoseconds>() - m_startTime >= m_duration) {
 			if (OnElapsed)
 				OnElapsed();
 			m_elapsedCount++;
 			if (m_repeat)
-				m_startTime = GameTime::GetTotalTime<std::chrono::duration<float>>();
+				m_startTime = GameTime::GetTotalTime<nanoseconds>();
 			else
 				m_active = false;
 			return true;
@@ -153,13 +263,13 @@ public:
 
 	void Reset()
 	{
-		m_startTime = GameTime::GetTotalTime<std::chrono::duration<float>>();
+		m_startTime = GameTime::GetTotalTime<nanoseconds>();
 		m_active = true;
 	}
 
 	DurationResult Duration() const {
 		using namespace std::chrono;
-		auto ns = duration_cast<nanoseconds>(m_duration).count();
+		auto ns = m_duration.count();
 
 		if (ns < 1'000)
 			return { static_cast<float>(ns), TimeUnit::Nanoseconds };
@@ -188,55 +298,530 @@ public:
 	}
 
 private:
-	std::chrono::duration<float> m_startTime;
-	std::chrono::duration<float> m_duration;
+	friend class TimerCollection;
+
+	nanoseconds m_startTime;
+	nanoseconds m_duration;
 	bool m_active = false;
 	bool m_repeat = false;
 
 	uint64_t m_elapsedCount = 0;
 };
 
+// Stable reference to a timer in a TimerCollection. A handle whose timer has been
+// removed is detected by its generation and ignored rather than dangling.
+struct TimerHandle
+{
+	uint32_t Index = UINT32_MAX;
+	uint32_t Generation = 0;
+
+	bool operator==(const TimerHandle&) const = default;
+};
+
+// Identifies a timer scheduled from another thread with TimerCollection::ScheduleAsync.
+struct TimerTicket
+{
+	uint64_t Id = 0;
+
+	explicit operator bool() const { return Id != 0; }
+	bool operator==(const TimerTicket&) const = default;
+};
+
+// Per-thread inbox for timers scheduled with ScheduleAsync. Callbacks stay with the
+// requesting thread and run from Dispatch(); the owning thread only posts tickets.
+// Must outlive the timers scheduled against it.
+class TimerDeliveryQueue
+{
+public:
+	using Callback = utils::InlineFunction<void()>;
+
+	explicit TimerDeliveryQueue(size_t capacity = 1024)
+		: m_expired(capacity)
+	{
+	}
+
+	TimerDeliveryQueue(const TimerDeliveryQueue&) = delete;
+	TimerDeliveryQueue& operator=(const TimerDeliveryQueue&) = delete;
+
+	// Call from the requesting thread. Returns the number of callbacks run.
+	size_t Dispatch()
+	{
+		// Final deliveries that didn't fit are taken first and run last, so whatever was
+		// queued for their ticket before them is delivered before them.
+		std::vector<Delivery> overflow;
+		if (m_hasOverflow.load(std::memory_order_acquire))
+		{
+			std::lock_guard lock(m_overflowMutex);
+			overflow.swap(m_overflow);
+			m_hasOverflow.store(false, std::memory_order_relaxed);
+		}
+
+		size_t count = 0;
+		Delivery delivery;
+		while (m_expired.TryPop([&](Delivery& d) { delivery = d; }))
+			count += Deliver(delivery);
+		for (const Delivery& final : overflow)
+			count += Deliver(final);
+		return count;
+	}
+
+	// Repeat deliveries lost because the queue was full when a timer fired. Final and
+	// cancelling deliveries are never lost, since they release the callback.
+	uint64_t GetDroppedCount() const
+	{
+		return m_dropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	friend class TimerCollection;
+
+	struct Delivery
+	{
+		uint64_t Ticket = 0;
+		bool Final = false;     // no more deliveries follow for this ticket
+		bool Cancelled = false; // drop the callback without running it
+	};
+
+	void Post(uint64_t ticket, bool final, bool cancelled)
+	{
+		if (m_expired.TryPush([&](Delivery& d) { d = { ticket, final, cancelled }; }))
+			return;
+
+		if (!final)
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		std::lock_guard lock(m_overflowMutex);
+		m_overflow.push_back({ ticket, final, cancelled });
+		m_hasOverflow.store(true, std::memory_order_release);
+	}
+
+	// Runs or discards one delivery. Returns 1 if a callback ran.
+	size_t Deliver(const Delivery& delivery)
+	{
+		auto it = m_callbacks.find(delivery.Ticket);
+		if (it == m_callbacks.end())
+			return 0;
+
+		size_t ran = 0;
+		if (!delivery.Cancelled)
+		{
+			it->second();
+			ran = 1;
+		}
+		if (delivery.Final)
+			m_callbacks.erase(delivery.Ticket); // the callback may have grown the map
+		return ran;
+	}
+
+	utils::LockFreeRingBuffer<Delivery> m_expired;
+	std::unordered_map<uint64_t, Callback> m_callbacks; // requesting thread only
+	std::atomic<uint64_t> m_dropped{ 0 };
+
+	// Final deliveries posted while m_expired was full; rare, so a lock is fine here.
+	std::mutex m_overflowMutex;
+	std::vector<Delivery> m_overflow;
+	std::atomic<bool> m_hasOverflow{ false };
+};
+
+// Timers are pooled in parallel arrays indexed by handle and kept in a hierarchical
+// timing wheel keyed on their deadline, so CheckTimers only touches timers that are
+// due. Due timers fire in the order they were added. Slots and callback storage are
+// reused, so nothing allocates once the pool has reached its working size.
+// Everything except ScheduleAsync/CancelAsync must be called from the owning thread.
 class TimerCollection
 {
 public:
 	enum class StartMode { ManualStart, StartImmediately };
+	using Callback = utils::InlineFunction<void()>;
+
+	// Wheel resolution; exact expiry is still decided on the nanosecond deadline.
+	static constexpr uint64_t TicksPerSecond = 1000;
+	static constexpr int64_t NanosecondsPerTick = 1'000'000'000 / TicksPerSecond;
 
 public:
+	// Timers follow the given clock, so a collection per simulation can run scaled or stepped.
+	explicit TimerCollection(GameTime& time = GameTime::Current())
+		: m_time(&time), m_wheel(CurrentTick())
+	{
+	}
+
+	TimerCollection(const TimerCollection&) = delete;
+	TimerCollection& operator=(const TimerCollection&) = delete;
+
 	void CheckTimers()
 	{
-		m_timers.erase(
-			std::remove_if(m_timers.begin(), m_timers.end(),
-				[](const std::unique_ptr<GameTimer>& t) {
-					return t->Elapsed() && !t->IsRepeating();
-				}),
-			m_timers.end()
-		);
+		ApplyCommands();
+
+		// One tick of lookahead so a timer due within the current tick isn't a frame late.
+		m_due.clear();
+		m_wheel.Advance(CurrentTick() + 1, m_due);
+		if (m_due.empty())
+			return;
+
+		std::sort(m_due.begin(), m_due.end(), [this](uint32_t a, uint32_t b) { return m_order[a] < m_order[b]; });
+		m_firing.clear();
+		for (uint32_t index : m_due)
+			m_firing.push_back({ index, m_generation[index] });
+
+		const nanoseconds now = m_time->Total<nanoseconds>();
+		for (const TimerHandle& handle : m_firing)
+		{
+			// An earlier callback may have removed this timer or stopped it.
+			if (!IsActive(handle))
+				continue;
+
+			const uint32_t i = handle.Index;
+			if (now < m_deadline[i])
+			{
+				Schedule(i);
+				continue;
+			}
+
+			// Run the callback from a local so it survives the timer being removed
+			// or the pool growing while it executes.
+			Callback callback = std::move(m_callbacks[i]);
+			if (callback)
+				callback();
+			if (!IsValid(handle))
+				continue;
+			if (!m_callbacks[i])
+				m_callbacks[i] = std::move(callback);
+
+			m_elapsedCount[i]++;
+			if (m_flags[i] & FlagRepeat)
+			{
+				// Respect a Stop() from the callback, and a Reset()/Start() that already rescheduled it.
+				if (!m_wheel.IsScheduled(i))
+				{
+					m_deadline[i] = now + m_duration[i];
+					if (m_flags[i] & FlagActive)
+						Schedule(i);
+				}
+			}
+			else
+			{
+				m_deliveries[i] = nullptr; // its callback already posted the final delivery
+				RemoveTimer(handle);
+			}
+		}
 	}
 
-	GameTimer* AddTimer(GameTimer timer, StartMode start = StartMode::ManualStart)
+	template<typename Rep, typename Period>
+	TimerHandle AddTimer(duration<Rep, Period> dur, Callback onElapsed = nullptr, bool repeat = false, StartMode start = StartMode::ManualStart)
 	{
-		m_timers.push_back(std::make_unique<GameTimer>(std::move(timer)));
+		const uint32_t i = AllocateSlot();
+		m_duration[i] = duration_cast<nanoseconds>(dur);
+		m_deadline[i] = m_time->Total<nanoseconds>() + m_duration[i];
+		m_flags[i] = FlagAlive | (repeat ? FlagRepeat : 0);
+		m_elapsedCount[i] = 0;
+		m_order[i] = m_nextOrder++;
+		m_callbacks[i] = std::move(onElapsed);
+
+		const TimerHandle handle{ i, m_generation[i] };
 		if (start == StartMode::StartImmediately)
-			m_timers.back()->Start();
-		return m_timers.back().get();
+			Start(handle);
+		return handle;
 	}
 
-	void RemoveTimer(GameTimer* timer)
+	// Takes over a standalone timer, including its state and OnElapsed callback.
+	TimerHandle AddTimer(GameTimer timer, StartMode start = StartMode::ManualStart)
 	{
-		m_timers.erase(
-			std::remove_if(m_timers.begin(), m_timers.end(),
-				[timer](const std::unique_ptr<GameTimer>& t) {
-					return t.get() == timer;
-				}),
-			m_timers.end()
-		);
+		Callback callback;
+		if (timer.OnElapsed)
+			callback = std::move(timer.OnElapsed);
+
+		const TimerHandle handle = AddTimer(timer.m_duration, std::move(callback), timer.m_repeat);
+		m_deadline[handle.Index] = timer.m_startTime + timer.m_duration;
+		m_elapsedCount[handle.Index] = timer.m_elapsedCount;
+		if (timer.m_active)
+			Resume(handle);
+		else if (start == StartMode::StartImmediately)
+			Start(handle);
+		return handle;
+	}
+
+	bool RemoveTimer(TimerHandle handle)
+	{
+		if (!IsValid(handle))
+			return false;
+
+		const uint32_t i = handle.Index;
+		if (m_tickets[i])
+		{
+			if (m_deliveries[i])
+				m_deliveries[i]->Post(m_tickets[i], true, true);
+			m_ticketSlots.erase(m_tickets[i]);
+			m_tickets[i] = 0;
+			m_deliveries[i] = nullptr;
+		}
+		m_wheel.Cancel(i);
+		m_callbacks[i].Reset();
+		m_flags[i] = 0;
+		m_generation[i]++;
+		m_freeSlots.push_back(i);
+		--m_count;
+		return true;
 	}
 
 	void ClearTimers()
 	{
-		m_timers.clear();
+		for (uint32_t i = 0; i < m_flags.size(); ++i)
+		{
+			if (m_flags[i] & FlagAlive)
+				RemoveTimer({ i, m_generation[i] });
+		}
+	}
+
+	// Grows the pool up front so adding up to count timers won't allocate.
+	void Reserve(size_t count)
+	{
+		m_deadline.reserve(count);
+		m_duration.reserve(count);
+		m_flags.reserve(count);
+		m_generation.reserve(count);
+		m_elapsedCount.reserve(count);
+		m_order.reserve(count);
+		m_callbacks.reserve(count);
+		m_tickets.reserve(count);
+		m_deliveries.reserve(count);
+		m_freeSlots.reserve(count);
+		m_due.reserve(count);
+		m_firing.reserve(count);
+	}
+
+	size_t Size() const
+	{
+		return m_count;
+	}
+
+	bool IsValid(TimerHandle handle) const
+	{
+		return handle.Index < m_generation.size() && m_generation[handle.Index] == handle.Generation && (m_flags[handle.Index] & FlagAlive);
+	}
+
+	bool IsActive(TimerHandle handle) const
+	{
+		return IsValid(handle) && (m_flags[handle.Index] & FlagActive);
+	}
+
+	bool IsRepeating(TimerHandle handle) const
+	{
+		return IsValid(handle) && (m_flags[handle.Index] & FlagRepeat);
+	}
+
+	bool HasElapsedOnce(TimerHandle handle) const
+	{
+		return IsValid(handle) && m_elapsedCount[handle.Index] > 0;
+	}
+
+	uint64_t GetElapsedCount(TimerHandle handle) const
+	{
+		return IsValid(handle) ? m_elapsedCount[handle.Index] : 0;
+	}
+
+	void Start(TimerHandle handle)
+	{
+		if (IsValid(handle) && !(m_flags[handle.Index] & FlagActive))
+		{
+			m_deadline[handle.Index] = m_time->Total<nanoseconds>() + m_duration[handle.Index];
+			m_flags[handle.Index] |= FlagActive;
+			Schedule(handle.Index);
+		}
+	}
+
+	void Resume(TimerHandle handle)
+	{
+		if (IsValid(handle) && !(m_flags[handle.Index] & FlagActive))
+		{
+			m_flags[handle.Index] |= FlagActive;
+			Schedule(handle.Index);
+		}
+	}
+
+	void Stop(TimerHandle handle)
+	{
+		if (IsValid(handle))
+		{
+			m_flags[handle.Index] &= ~FlagActive;
+			m_wheel.Cancel(handle.Index);
+		}
+	}
+
+	void Reset(TimerHandle handle)
+	{
+		if (IsValid(handle))
+		{
+			m_deadline[handle.Index] = m_time->Total<nanoseconds>() + m_duration[handle.Index];
+			m_flags[handle.Index] |= FlagActive;
+			Schedule(handle.Index);
+		}
+	}
+
+	// Turns on the thread-safe front end. Call from the owning thread before other
+	// threads use ScheduleAsync; capacity bounds the commands pending between checks.
+	void EnableAsync(size_t capacity = 1024)
+	{
+		if (!m_commands)
+			m_commands = std::make_unique<utils::LockFreeRingBuffer<Command>>(capacity);
+	}
+
+	// Any thread: queues a timer to be added at the start of the next CheckTimers.
+	// With a delivery queue the callback runs from that queue's Dispatch() on the calling
+	// thread (which must own the queue); otherwise it runs on the owning thread.
+	// Returns an empty ticket if async is off or the command queue is full.
+	template<typename Rep, typename Period>
+	TimerTicket ScheduleAsync(duration<Rep, Period> dur, Callback onElapsed, bool repeat = false, TimerDeliveryQueue* delivery = nullptr)
+	{
+		if (!m_commands)
+			return {};
+
+		const uint64_t ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+		uint64_t pos;
+		if (!m_commands->TryClaimWrite(pos))
+			return {};
+
+		if (delivery)
+		{
+			delivery->m_callbacks.insert_or_assign(ticket, std::move(onElapsed));
+			onElapsed = [delivery, ticket, repeat] { delivery->Post(ticket, !repeat, false); };
+		}
+
+		Command& command = m_commands->At(pos);
+		command.Type = CommandType::Add;
+		command.Ticket = ticket;
+		command.Duration = duration_cast<nanoseconds>(dur);
+		command.Repeat = repeat;
+		command.Delivery = delivery;
+		command.OnElapsed = std::move(onElapsed);
+		m_commands->Publish(pos);
+		return { ticket };
+	}
+
+	// Any thread: queues removal of a timer scheduled with ScheduleAsync.
+	// Returns false if async is off or the command queue is full.
+	bool CancelAsync(TimerTicket ticket)
+	{
+		if (!m_commands || !ticket)
+			return false;
+
+		return m_commands->TryPush([&](Command& command) {
+			command.Type = CommandType::Cancel;
+			command.Ticket = ticket.Id;
+		});
+	}
+
+	// Replacing the callback of the timer that is currently firing takes effect from its next expiry.
+	void SetCallback(TimerHandle handle, Callback onElapsed)
+	{
+		if (IsValid(handle))
+			m_callbacks[handle.Index] = std::move(onElapsed);
 	}
 
 private:
-	std::vector<std::unique_ptr<GameTimer>> m_timers;
+	enum : uint8_t
+	{
+		FlagAlive = 1 << 0,
+		FlagActive = 1 << 1,
+		FlagRepeat = 1 << 2
+	};
+
+	uint64_t CurrentTick() const
+	{
+		return static_cast<uint64_t>(m_time->Total<nanoseconds>().count() / NanosecondsPerTick);
+	}
+
+	enum class CommandType : uint8_t { Add, Cancel };
+
+	struct Command
+	{
+		CommandType Type = CommandType::Add;
+		bool Repeat = false;
+		uint64_t Ticket = 0;
+		nanoseconds Duration{};
+		TimerDeliveryQueue* Delivery = nullptr;
+		Callback OnElapsed;
+	};
+
+	void ApplyCommands()
+	{
+		if (!m_commands)
+			return;
+
+		uint64_t pos;
+		while (m_commands->TryClaimRead(pos))
+		{
+			Command& command = m_commands->At(pos);
+			if (command.Type == CommandType::Add)
+			{
+				const TimerHandle handle = AddTimer(command.Duration, std::move(command.OnElapsed), command.Repeat, StartMode::StartImmediately);
+				m_tickets[handle.Index] = command.Ticket;
+				m_deliveries[handle.Index] = command.Delivery;
+				m_ticketSlots[command.Ticket] = handle;
+			}
+			else if (auto it = m_ticketSlots.find(command.Ticket); it != m_ticketSlots.end())
+				RemoveTimer(it->second);
+
+			command.OnElapsed.Reset();
+			command.Delivery = nullptr;
+			m_commands->Release(pos);
+		}
+	}
+
+	uint32_t AllocateSlot()
+	{
+		++m_count;
+		if (!m_freeSlots.empty())
+		{
+			const uint32_t i = m_freeSlots.back();
+			m_freeSlots.pop_back();
+			return i;
+		}
+
+		m_deadline.emplace_back();
+		m_duration.emplace_back();
+		m_flags.push_back(0);
+		m_generation.push_back(1);
+		m_elapsedCount.push_back(0);
+		m_order.push_back(0);
+		m_callbacks.emplace_back();
+		m_tickets.push_back(0);
+		m_deliveries.push_back(nullptr);
+		return static_cast<uint32_t>(m_flags.size() - 1);
+	}
+
+	void Schedule(uint32_t i)
+	{
+		const int64_t deadline = m_deadline[i].count();
+		m_wheel.Schedule(i, deadline > 0 ? static_cast<uint64_t>((deadline + NanosecondsPerTick - 1) / NanosecondsPerTick) : 0);
+	}
+
+	// Hot data, one entry per slot.
+	std::vector<nanoseconds> m_deadline; // GameTime total time at which the timer fires
+	std::vector<nanoseconds> m_duration;
+	std::vector<uint8_t> m_flags;
+	std::vector<uint32_t> m_generation;
+
+	// Cold data, touched only when a timer fires.
+	std::vector<uint64_t> m_elapsedCount;
+	std::vector<uint64_t> m_order;
+	std::vector<Callback> m_callbacks;
+	std::vector<uint64_t> m_tickets;                 // 0 unless added through ScheduleAsync
+	std::vector<TimerDeliveryQueue*> m_deliveries;
+
+	GameTime* m_time;
+	std::vector<uint32_t> m_freeSlots;
+	size_t m_count = 0;
+	uint64_t m_nextOrder = 0;
+
+	utils::TimingWheel m_wheel;
+	std::vector<uint32_t> m_due;
+	std::vector<TimerHandle> m_firing;
+
+	// Thread-safe front end, see EnableAsync.
+	std::unique_ptr<utils::LockFreeRingBuffer<Command>> m_commands;
+	std::unordered_map<uint64_t, TimerHandle> m_ticketSlots;
+	std::atomic<uint64_t> m_nextTicket{ 1 };
 };
\ No newline at end of file
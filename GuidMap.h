@@ -0,0 +1,363 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "GUID.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAMEUTILS_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace utils
+{
+    // Open-addressing hash map keyed by GUID, laid out like a SwissTable: every slot
+    // has a control byte holding 7 bits of its hash (or empty/deleted), and lookups
+    // compare a group of 16 control bytes at once, touching a key only on a 7-bit match.
+    // Keys and values live inline in one array; pointers are invalidated by rehashing.
+    template<typename T>
+    class GuidMap
+    {
+    public:
+        static constexpr size_t GroupSize = 16;
+
+        GuidMap() = default;
+
+        explicit GuidMap(size_t capacity)
+        {
+            Reserve(capacity);
+        }
+
+        GuidMap(GuidMap&& other) noexcept
+        {
+            Swap(other);
+        }
+
+        GuidMap& operator=(GuidMap&& other) noexcept
+        {
+            if (this != &other)
+            {
+                GuidMap empty;
+                Swap(empty);
+                Swap(other);
+            }
+            return *this;
+        }
+
+        GuidMap(const GuidMap&) = delete;
+        GuidMap& operator=(const GuidMap&) = delete;
+
+        ~GuidMap()
+        {
+            DestroySlots();
+            Deallocate(m_slots, m_capacity);
+        }
+
+        T* Find(const GUID& key)
+        {
+            const size_t index = FindIndex(key);
+            return index == NotFound ? nullptr : &m_slots[index].value;
+        }
+
+        const T* Find(const GUID& key) const
+        {
+            const size_t index = FindIndex(key);
+            return index == NotFound ? nullptr : &m_slots[index].value;
+        }
+
+        bool Contains(const GUID& key) const
+        {
+            return FindIndex(key) != NotFound;
+        }
+
+        // Constructs the value from args if the key is absent. Returns the value and
+        // whether it was inserted.
+        template<typename... Args>
+        std::pair<T*, bool> Emplace(const GUID& key, Args&&... args)
+        {
+            const size_t hash = key.Hash();
+            const size_t existing = FindIndex(key, hash);
+            if (existing != NotFound)
+                return { &m_slots[existing].value, false };
+
+            if (m_growthLeft == 0)
+                Grow();
+
+            // Construct before claiming the slot so a throwing constructor leaves the map unchanged.
+            const size_t index = FindInsertIndex(hash);
+            ::new (&m_slots[index]) Slot{ key, T(std::forward<Args>(args)...) };
+            if (m_ctrl[index] == CtrlEmpty)
+                --m_growthLeft;
+            SetCtrl(index, H2(hash));
+            ++m_size;
+            return { &m_slots[index].value, true };
+        }
+
+        std::pair<T*, bool> Insert(const GUID& key, T value)
+        {
+            return Emplace(key, std::move(value));
+        }
+
+        T& operator[](const GUID& key)
+        {
+            return *Emplace(key).first;
+        }
+
+        bool Erase(const GUID& key)
+        {
+            const size_t index = FindIndex(key);
+            if (index == NotFound)
+                return false;
+
+            m_slots[index].~Slot();
+            --m_size;
+
+            // A slot can go back to empty if its group already has an empty one, since
+            // probing stops at that group either way. Otherwise leave a tombstone.
+            if (MatchEmpty(&m_ctrl[index & ~(GroupSize - 1)]) != 0)
+            {
+                SetCtrl(index, CtrlEmpty);
+                ++m_growthLeft;
+            }
+            else
+                SetCtrl(index, CtrlDeleted);
+            return true;
+        }
+
+        void Clear()
+        {
+            DestroySlots();
+            if (m_capacity > 0)
+                std::memset(m_ctrl.get(), static_cast<uint8_t>(CtrlEmpty), m_capacity);
+            m_size = 0;
+            m_growthLeft = MaxLoad(m_capacity);
+        }
+
+        // Makes room for count entries without further rehashing.
+        void Reserve(size_t count)
+        {
+            if (count > m_size + m_growthLeft)
+                Rehash(std::max(CapacityFor(count), m_capacity));
+        }
+
+        // Calls fn(const GUID&, T&) for every entry, in table order.
+        template<typename F>
+        void ForEach(F&& fn)
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                if (IsFull(m_ctrl[i]))
+                    fn(static_cast<const GUID&>(m_slots[i].key), m_slots[i].value);
+            }
+        }
+
+        template<typename F>
+        void ForEach(F&& fn) const
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                if (IsFull(m_ctrl[i]))
+                    fn(m_slots[i].key, static_cast<const T&>(m_slots[i].value));
+            }
+        }
+
+        size_t Size() const { return m_size; }
+        bool Empty() const { return m_size == 0; }
+        size_t Capacity() const { return m_capacity; }
+
+    private:
+        struct Slot
+        {
+            GUID key;
+            T value;
+        };
+
+        static constexpr int8_t CtrlEmpty = -128;  // 0b10000000
+        static constexpr int8_t CtrlDeleted = -2;  // 0b11111110
+        static constexpr size_t NotFound = SIZE_MAX;
+
+        static bool IsFull(int8_t ctrl) { return ctrl >= 0; }
+        static size_t H1(size_t hash) { return hash >> 7; }
+        static int8_t H2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+        // Capacity less 1/8 headroom so every probe sequence reaches an empty slot.
+        static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+#if defined(GAMEUTILS_HAS_SSE2)
+        // Bit i set when control byte i equals h2.
+        static uint32_t Match(const int8_t* group, int8_t h2)
+        {
+            const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+        }
+
+        // Empty and deleted are the only control bytes with the sign bit set.
+        static uint32_t MatchEmptyOrDeleted(const int8_t* group)
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+        }
+#else
+        static uint32_t Match(const int8_t* group, int8_t h2)
+        {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < GroupSize; ++i)
+                mask |= static_cast<uint32_t>(group[i] == h2) << i;
+            return mask;
+        }
+
+        static uint32_t MatchEmptyOrDeleted(const int8_t* group)
+        {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < GroupSize; ++i)
+                mask |= static_cast<uint32_t>(group[i] < 0) << i;
+            return mask;
+        }
+#endif
+
+        static uint32_t MatchEmpty(const int8_t* group)
+        {
+            return Match(group, CtrlEmpty);
+        }
+
+        size_t FindIndex(const GUID& key) const
+        {
+            return FindIndex(key, key.Hash());
+        }
+
+        // Groups are probed triangularly (+1, +2, +3...), which visits every group of a
+        // power-of-two table, and a group holding an empty slot ends the search.
+        size_t FindIndex(const GUID& key, size_t hash) const
+        {
+            if (m_size == 0)
+                return NotFound;
+
+            const size_t groupMask = m_capacity / GroupSize - 1;
+            const int8_t h2 = H2(hash);
+            size_t group = H1(hash) & groupMask;
+            for (size_t step = 1;; ++step)
+            {
+                const int8_t* ctrl = &m_ctrl[group * GroupSize];
+                for (uint32_t match = Match(ctrl, h2); match != 0; match &= match - 1)
+                {
+                    const size_t index = group * GroupSize + std::countr_zero(match);
+                    if (m_slots[index].key == key)
+                        return index;
+                }
+                if (MatchEmpty(ctrl) != 0)
+                    return NotFound;
+                group = (group + step) & groupMask;
+            }
+        }
+
+        size_t FindInsertIndex(size_t hash) const
+        {
+            const size_t groupMask = m_capacity / GroupSize - 1;
+            size_t group = H1(hash) & groupMask;
+            for (size_t step = 1;; ++step)
+            {
+                const uint32_t free = MatchEmptyOrDeleted(&m_ctrl[group * GroupSize]);
+                if (free != 0)
+                    return group * GroupSize + std::countr_zero(free);
+                group = (group + step) & groupMask;
+            }
+        }
+
+        void SetCtrl(size_t index, int8_t value)
+        {
+            m_ctrl[index] = value;
+        }
+
+        static size_t CapacityFor(size_t count)
+        {
+            size_t capacity = GroupSize;
+            while (MaxLoad(capacity) < count)
+                capacity <<= 1;
+            return capacity;
+        }
+
+        // Called when no empty slot is left to claim. Tombstones are reclaimed at the same
+        // capacity only while live entries fill at most 25/32 of it; closer to max load that
+        // would free just a few slots, and erase/insert churn would rehash on every insert.
+        void Grow()
+        {
+            if (m_capacity == 0)
+                Rehash(GroupSize);
+            else if (m_size <= m_capacity * 25 / 32)
+                Rehash(m_capacity);
+            else
+                Rehash(m_capacity * 2);
+        }
+
+        // Rebuilds the table at the given capacity, dropping tombstones.
+        void Rehash(size_t capacity)
+        {
+            std::unique_ptr<int8_t[]> oldCtrl = std::move(m_ctrl);
+            Slot* oldSlots = m_slots;
+            const size_t oldCapacity = m_capacity;
+
+            m_ctrl = std::make_unique<int8_t[]>(capacity);
+            std::memset(m_ctrl.get(), static_cast<uint8_t>(CtrlEmpty), capacity);
+            m_slots = Allocate(capacity);
+            m_capacity = capacity;
+            m_growthLeft = MaxLoad(capacity) - m_size;
+
+            for (size_t i = 0; i < oldCapacity; ++i)
+            {
+                if (!IsFull(oldCtrl[i]))
+                    continue;
+
+                Slot& slot = oldSlots[i];
+                const size_t hash = slot.key.Hash();
+                const size_t index = FindInsertIndex(hash);
+                SetCtrl(index, H2(hash));
+                ::new (&m_slots[index]) Slot{ slot.key, std::move(slot.value) };
+                slot.~Slot();
+            }
+            Deallocate(oldSlots, oldCapacity);
+        }
+
+        void DestroySlots()
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (size_t i = 0; i < m_capacity; ++i)
+                {
+                    if (IsFull(m_ctrl[i]))
+                        m_slots[i].~Slot();
+                }
+            }
+        }
+
+        static Slot* Allocate(size_t capacity)
+        {
+            return static_cast<Slot*>(::operator new(capacity * sizeof(Slot), std::align_val_t(alignof(Slot))));
+        }
+
+        static void Deallocate(Slot* slots, size_t capacity)
+        {
+            if (slots)
+                ::operator delete(slots, capacity * sizeof(Slot), std::align_val_t(alignof(Slot)));
+        }
+
+        void Swap(GuidMap& other) noexcept
+        {
+            std::swap(m_ctrl, other.m_ctrl);
+            std::swap(m_slots, other.m_slots);
+            std::swap(m_capacity, other.m_capacity);
+            std::swap(m_size, other.m_size);
+            std::swap(m_growthLeft, other.m_growthLeft);
+        }
+
+        std::unique_ptr<int8_t[]> m_ctrl;
+        Slot* m_slots = nullptr;
+        size_t m_capacity = 0;
+        size_t m_size = 0;
+        size_t m_growthLeft = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,246 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "GUID.h"
+#include "GuidMap.h"
+
+namespace utils
+{
+    // Compact runtime identity for an interned GUID. Index is dense (freed indexes are
+    // reused), so it can address arrays and bitsets; Generation tells a stale handle
+    // from the GUID that reused its index.
+    struct GuidHandle
+    {
+        uint32_t Index = UINT32_MAX;
+        uint32_t Generation = 0;
+
+        explicit operator bool() const { return Index != UINT32_MAX; }
+        bool operator==(const GuidHandle&) const = default;
+    };
+
+    // Thread-safe interning of GUIDs into GuidHandles. GUID to handle goes through a
+    // sharded map under a reader/writer lock per shard; handle to GUID is a lock-free
+    // read of a paged slot array, validated by the slot's generation like a seqlock.
+    class GuidRegistry
+    {
+    public:
+        static constexpr uint32_t PageBits = 12;
+        static constexpr uint32_t PageSize = 1u << PageBits;
+
+        // maxCount bounds the number of live GUIDs; slot pages are allocated as needed.
+        explicit GuidRegistry(uint32_t maxCount = 1u << 24)
+            : m_pageCount((maxCount + PageSize - 1) / PageSize),
+              m_pages(std::make_unique<std::atomic<Slot*>[]>(m_pageCount))
+        {
+            for (uint32_t i = 0; i < m_pageCount; ++i)
+                m_pages[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        GuidRegistry(const GuidRegistry&) = delete;
+        GuidRegistry& operator=(const GuidRegistry&) = delete;
+
+        // Returns the GUID's handle, interning it first if needed. An empty handle means
+        // the registry is full.
+        GuidHandle Intern(const GUID& guid)
+        {
+            Shard& shard = ShardFor(guid);
+            {
+                std::shared_lock lock(shard.mutex);
+                if (const uint32_t* index = shard.indices.Find(guid))
+                    return HandleOf(*index);
+            }
+
+            std::unique_lock lock(shard.mutex);
+            if (const uint32_t* index = shard.indices.Find(guid))
+                return HandleOf(*index);
+
+            const uint32_t index = AllocateIndex();
+            if (index == UINT32_MAX)
+                return {};
+
+            uint64_t halves[2];
+            std::memcpy(halves, &guid, sizeof(halves));
+            Slot& slot = SlotAt(index);
+            // Pairs with the fence in TryResolve: a reader that sees these stores also sees
+            // the generation bump from when the slot was last released.
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.high.store(halves[0], std::memory_order_relaxed);
+            slot.low.store(halves[1], std::memory_order_relaxed);
+
+            shard.indices.Insert(guid, index);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            return { index, slot.generation.load(std::memory_order_relaxed) };
+        }
+
+        // Handle of an already interned GUID, or an empty handle.
+        GuidHandle Find(const GUID& guid) const
+        {
+            const Shard& shard = ShardFor(guid);
+            std::shared_lock lock(shard.mutex);
+            const uint32_t* index = shard.indices.Find(guid);
+            return index ? HandleOf(*index) : GuidHandle{};
+        }
+
+        // Drops the GUID; its index is reused and handles to it stop resolving.
+        bool Release(GuidHandle handle)
+        {
+            GUID guid;
+            if (!TryResolve(handle, guid))
+                return false;
+
+            Shard& shard = ShardFor(guid);
+            std::unique_lock lock(shard.mutex);
+            Slot& slot = SlotAt(handle.Index);
+            if (slot.generation.load(std::memory_order_relaxed) != handle.Generation)
+                return false; // Released by another thread in the meantime
+
+            shard.indices.Erase(guid);
+            slot.generation.fetch_add(1, std::memory_order_relaxed);
+            FreeIndex(handle.Index);
+            m_count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool TryResolve(GuidHandle handle, GUID& guid) const
+        {
+            const Slot* slot = FindSlot(handle.Index);
+            if (!slot)
+                return false;
+
+            const uint32_t before = slot->generation.load(std::memory_order_acquire);
+            if (before != handle.Generation)
+                return false;
+
+            const uint64_t halves[2] = {
+                slot->high.load(std::memory_order_relaxed),
+                slot->low.load(std::memory_order_relaxed)
+            };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->generation.load(std::memory_order_relaxed) != before)
+                return false;
+
+            std::memcpy(&guid, halves, sizeof(halves));
+            return true;
+        }
+
+        // The handle's GUID, or the nil GUID if the handle is stale.
+        GUID Resolve(GuidHandle handle) const
+        {
+            GUID guid;
+            TryResolve(handle, guid);
+            return guid;
+        }
+
+        bool IsValid(GuidHandle handle) const
+        {
+            const Slot* slot = FindSlot(handle.Index);
+            return slot && slot->generation.load(std::memory_order_acquire) == handle.Generation;
+        }
+
+        size_t Size() const
+        {
+            return m_count.load(std::memory_order_relaxed);
+        }
+
+        // One past the highest index handed out so far, for sizing index-addressed arrays.
+        uint32_t GetIndexBound() const
+        {
+            return m_indexBound.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> high{ 0 };
+            std::atomic<uint64_t> low{ 0 };
+            std::atomic<uint32_t> generation{ 1 };
+        };
+
+        struct alignas(64) Shard
+        {
+            mutable std::shared_mutex mutex;
+            GuidMap<uint32_t> indices;
+        };
+
+        static constexpr size_t ShardCount = 64;
+
+        Shard& ShardFor(const GUID& guid)
+        {
+            return m_shards[ShardIndex(guid)];
+        }
+
+        const Shard& ShardFor(const GUID& guid) const
+        {
+            return m_shards[ShardIndex(guid)];
+        }
+
+        // Top bits of the hash; GuidMap uses the low ones.
+        static size_t ShardIndex(const GUID& guid)
+        {
+            return (guid.Hash() >> (sizeof(size_t) * 8 - 6)) & (ShardCount - 1);
+        }
+
+        GuidHandle HandleOf(uint32_t index) const
+        {
+            return { index, SlotAt(index).generation.load(std::memory_order_relaxed) };
+        }
+
+        Slot& SlotAt(uint32_t index) const
+        {
+            return m_pages[index >> PageBits].load(std::memory_order_acquire)[index & (PageSize - 1)];
+        }
+
+        const Slot* FindSlot(uint32_t index) const
+        {
+            if (index >= GetIndexBound())
+                return nullptr;
+            const Slot* page = m_pages[index >> PageBits].load(std::memory_order_acquire);
+            return page ? &page[index & (PageSize - 1)] : nullptr;
+        }
+
+        uint32_t AllocateIndex()
+        {
+            std::lock_guard lock(m_allocMutex);
+            if (!m_freeIndices.empty())
+            {
+                const uint32_t index = m_freeIndices.back();
+                m_freeIndices.pop_back();
+                return index;
+            }
+
+            const uint32_t index = m_indexBound.load(std::memory_order_relaxed);
+            const uint32_t page = index >> PageBits;
+            if (page >= m_pageCount)
+                return UINT32_MAX;
+
+            if (!m_pages[page].load(std::memory_order_relaxed))
+            {
+                m_pageStorage.push_back(std::make_unique<Slot[]>(PageSize));
+                m_pages[page].store(m_pageStorage.back().get(), std::memory_order_release);
+            }
+            m_indexBound.store(index + 1, std::memory_order_release);
+            return index;
+        }
+
+        void FreeIndex(uint32_t index)
+        {
+            std::lock_guard lock(m_allocMutex);
+            m_freeIndices.push_back(index);
+        }
+
+        std::array<Shard, ShardCount> m_shards;
+        const uint32_t m_pageCount;
+        std::unique_ptr<std::atomic<Slot*>[]> m_pages;
+        std::vector<std::unique_ptr<Slot[]>> m_pageStorage;
+        std::vector<uint32_t> m_freeIndices;
+        std::mutex m_allocMutex;
+        std::atomic<uint32_t> m_indexBound{ 0 };
+        std::atomic<size_t> m_count{ 0 };
+    };
+}
\ No newline at end of file
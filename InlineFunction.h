@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <functional>
+#include <utility>
+
+namespace utils
+{
+    template<typename Signature, size_t Capacity = 64>
+    class InlineFunction;
+
+    // Move-only std::function replacement that never allocates: the callable must
+    // fit in Capacity bytes, which is checked at compile time.
+    template<typename R, typename... Args, size_t Capacity>
+    class InlineFunction<R(Args...), Capacity>
+    {
+    public:
+        InlineFunction() = default;
+        InlineFunction(std::nullptr_t) {}
+
+        template<typename F>
+            requires (!std::is_same_v<std::decay_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InlineFunction(F&& function)
+        {
+            using Callable = std::decay_t<F>;
+            static_assert(sizeof(Callable) <= Capacity, "Callable is too large for InlineFunction; capture less or capture a pointer.");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned for InlineFunction.");
+            static_assert(std::is_nothrow_move_constructible_v<Callable>, "InlineFunction requires a nothrow-movable callable.");
+
+            new (m_storage) Callable(std::forward<F>(function));
+            m_ops = &OpsFor<Callable>;
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction()
+        {
+            Reset();
+        }
+
+        void Reset()
+        {
+            if (m_ops)
+            {
+                m_ops->destroy(m_storage);
+                m_ops = nullptr;
+            }
+        }
+
+        explicit operator bool() const { return m_ops != nullptr; }
+
+        R operator()(Args... args)
+        {
+            return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+    private:
+        struct Ops
+        {
+            R(*invoke)(void*, Args&&...);
+            void(*move)(void* destination, void* source);
+            void(*destroy)(void*);
+        };
+
+        template<typename Callable>
+        static constexpr Ops OpsFor = {
+            [](void* self, Args&&... args) -> R { return std::invoke(*static_cast<Callable*>(self), std::forward<Args>(args)...); },
+            [](void* destination, void* source) { new (destination) Callable(std::move(*static_cast<Callable*>(source))); },
+            [](void* self) { static_cast<Callable*>(self)->~Callable(); }
+        };
+
+        void MoveFrom(InlineFunction& other)
+        {
+            if (other.m_ops)
+            {
+                other.m_ops->move(m_storage, other.m_storage);
+                m_ops = other.m_ops;
+                other.Reset();
+            }
+        }
+
+        alignas(std::max_align_t) unsigned char m_storage[Capacity];
+        const Ops* m_ops = nullptr;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace utils
+{
+    // Fixed-memory log-linear histogram in the style of HdrHistogram. Values below 128
+    // are exact; above that each power of two is split into 64 buckets, so any recorded
+    // value is reported within 1/64 (~1.6%) of itself. Values up to 2^40 (about 18
+    // minutes in nanoseconds) are tracked; larger ones land in the top bucket while
+    // Max() stays exact. Recording is a shift and an increment.
+    class LatencyHistogram
+    {
+    public:
+        static constexpr uint32_t SubBucketBits = 7;
+        static constexpr uint32_t MaxValueBits = 40;
+        static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+        static constexpr uint32_t HalfSubBucketCount = SubBucketCount / 2;
+        static constexpr uint32_t BucketCount = (MaxValueBits - SubBucketBits) * HalfSubBucketCount + SubBucketCount;
+
+        void Record(uint64_t value, uint64_t count = 1)
+        {
+            m_counts[BucketFor(value)] += count;
+            m_total += count;
+            m_sum += value * count;
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+
+        template<typename Rep, typename Period>
+        void Record(std::chrono::duration<Rep, Period> value)
+        {
+            Record(static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(value).count())));
+        }
+
+        // Same as Record, but safe for several threads recording into one histogram at once.
+        // Read it with Snapshot() while writers may still be running.
+        void RecordShared(uint64_t value)
+        {
+            std::atomic_ref<uint64_t>(m_counts[BucketFor(value)]).fetch_add(1, std::memory_order_relaxed);
+            std::atomic_ref<uint64_t>(m_total).fetch_add(1, std::memory_order_relaxed);
+            std::atomic_ref<uint64_t>(m_sum).fetch_add(value, std::memory_order_relaxed);
+
+            std::atomic_ref<uint64_t> min(m_min);
+            uint64_t seen = min.load(std::memory_order_relaxed);
+            while (value < seen && !min.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+                ;
+            std::atomic_ref<uint64_t> max(m_max);
+            seen = max.load(std::memory_order_relaxed);
+            while (value > seen && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+                ;
+        }
+
+        // Undoes one Record(value); used by rolling windows. Min/Max are not rolled back.
+        void Remove(uint64_t value)
+        {
+            uint64_t& bucket = m_counts[BucketFor(value)];
+            if (bucket == 0)
+                return;
+            --bucket;
+            --m_total;
+            m_sum -= value;
+        }
+
+        // Copy that is consistent per field even while RecordShared calls are in flight.
+        LatencyHistogram Snapshot() const
+        {
+            LatencyHistogram copy;
+            for (uint32_t i = 0; i < BucketCount; ++i)
+                copy.m_counts[i] = std::atomic_ref<const uint64_t>(m_counts[i]).load(std::memory_order_relaxed);
+            copy.m_total = std::atomic_ref<const uint64_t>(m_total).load(std::memory_order_relaxed);
+            copy.m_sum = std::atomic_ref<const uint64_t>(m_sum).load(std::memory_order_relaxed);
+            copy.m_min = std::atomic_ref<const uint64_t>(m_min).load(std::memory_order_relaxed);
+            copy.m_max = std::atomic_ref<const uint64_t>(m_max).load(std::memory_order_relaxed);
+            return copy;
+        }
+
+        // Adds another histogram's samples, e.g. to combine per-thread histograms.
+        void Merge(const LatencyHistogram& other)
+        {
+            for (uint32_t i = 0; i < BucketCount; ++i)
+                m_counts[i] += other.m_counts[i];
+            m_total += other.m_total;
+            m_sum += other.m_sum;
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        void Reset()
+        {
+            m_counts.fill(0);
+            m_total = 0;
+            m_sum = 0;
+            m_min = std::numeric_limits<uint64_t>::max();
+            m_max = 0;
+        }
+
+        uint64_t Count() const { return m_total; }
+        uint64_t Min() const { return m_total ? m_min : 0; }
+        uint64_t Max() const { return m_max; }
+        double Mean() const { return m_total ? static_cast<double>(m_sum) / static_cast<double>(m_total) : 0.0; }
+
+        // Smallest value such that percentile% of the samples are at or below it,
+        // reported as the top of its bucket (never above Max()).
+        uint64_t Percentile(double percentile) const
+        {
+            if (m_total == 0)
+                return 0;
+
+            const double clamped = std::clamp(percentile, 0.0, 100.0);
+            const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(m_total) + 0.5));
+            uint64_t seen = 0;
+            for (uint32_t i = 0; i < BucketCount; ++i)
+            {
+                seen += m_counts[i];
+                if (seen >= target)
+                    return std::min(HighestValueIn(i), m_max);
+            }
+            return m_max;
+        }
+
+        static constexpr uint32_t BucketFor(uint64_t value)
+        {
+            if (value < SubBucketCount)
+                return static_cast<uint32_t>(value);
+
+            const uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - SubBucketBits;
+            if (shift > MaxValueBits - SubBucketBits)
+                return BucketCount - 1;
+            return shift * HalfSubBucketCount + static_cast<uint32_t>(value >> shift);
+        }
+
+        static constexpr uint64_t HighestValueIn(uint32_t bucket)
+        {
+            if (bucket < SubBucketCount)
+                return bucket;
+
+            const uint32_t shift = bucket / HalfSubBucketCount - 1;
+            const uint64_t sub = bucket - shift * HalfSubBucketCount;
+            return ((sub + 1) << shift) - 1;
+        }
+
+    private:
+        std::array<uint64_t, BucketCount> m_counts{};
+        uint64_t m_total = 0;
+        uint64_t m_sum = 0;
+        uint64_t m_min = std::numeric_limits<uint64_t>::max();
+        uint64_t m_max = 0;
+    };
+}
\ No newline at end of file
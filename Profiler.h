@@ -0,0 +1,394 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "CustomRaylibLog.h"
+#include "RingBuffer.h"
+
+using ProfilerLog = TagLogger<"PROFILER", ConsoleColor::Magenta>;
+
+struct ProfileZoneStats
+{
+    std::string_view Name;
+    uint32_t Calls = 0;
+    std::chrono::nanoseconds Inclusive{ 0 };
+    std::chrono::nanoseconds Self{ 0 }; // inclusive minus time in nested zones
+};
+
+// Scope profiler. Each thread records finished zones into its own single-producer
+// ring, so the hot path is two clock reads and a store with no locks. MarkFrame
+// (called by GameTime::Update) drains all threads, builds the per-frame summary and
+// feeds an optional capture that can be saved as a Chrome/Perfetto trace.
+// Instrument with PROFILE_SCOPE, which compiles to nothing unless
+// GAMEUTILS_ENABLE_PROFILER is defined.
+class Profiler
+{
+public:
+    struct Event
+    {
+        const char* Name = nullptr; // must outlive the profiler, normally a string literal
+        uint64_t Start = 0;
+        uint64_t End = 0;
+    };
+
+    // Nanoseconds since the profiler's epoch.
+    static uint64_t Now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - Epoch()).count());
+    }
+
+    static void Record(const char* name, uint64_t start, uint64_t end)
+    {
+        ThreadBuffer& buffer = LocalBuffer();
+        if (!buffer.Events.TryPush({ name, start, end }))
+            buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Ends the current frame. Call from one thread only, normally via GameTime::Update.
+    static void MarkFrame()
+    {
+        State& state = GetState();
+        std::lock_guard lock(state.Mutex);
+
+        const uint64_t now = Now();
+        state.FrameEvents.clear();
+        for (size_t i = 0; i < state.Threads.size();)
+        {
+            ThreadBuffer& buffer = *state.Threads[i];
+            const bool retired = buffer.Retired.load(std::memory_order_acquire);
+            while (buffer.Events.TryPop([&](Event& e) { state.FrameEvents.push_back({ e, buffer.Id }); }))
+                ;
+            state.Dropped += buffer.Dropped.exchange(0, std::memory_order_relaxed);
+
+            if (retired)
+                state.Threads.erase(state.Threads.begin() + i);
+            else
+                ++i;
+        }
+
+        if (state.Capturing)
+        {
+            for (const ThreadEvent& event : state.FrameEvents)
+            {
+                if (state.Captured.size() >= state.CaptureLimit)
+                {
+                    state.Dropped++;
+                    continue;
+                }
+                state.Captured.push_back(event);
+            }
+            state.FrameMarks.push_back(now);
+        }
+
+        BuildSummary(state);
+        state.FrameStart = now;
+        state.FrameIndex++;
+    }
+
+    // Names the calling thread in exported traces.
+    static void SetThreadName(std::string name)
+    {
+        ThreadBuffer& buffer = LocalBuffer();
+        std::lock_guard lock(GetState().Mutex);
+        GetState().ThreadNames[buffer.Id] = std::move(name);
+    }
+
+    // Ring size for threads that haven't recorded anything yet.
+    static void SetThreadBufferCapacity(size_t events)
+    {
+        std::lock_guard lock(GetState().Mutex);
+        GetState().BufferCapacity = std::max<size_t>(64, events);
+    }
+
+    // Keeps every zone from now on (up to maxEvents) for WriteChromeTrace.
+    static void BeginCapture(size_t maxEvents = 1'000'000)
+    {
+        State& state = GetState();
+        std::lock_guard lock(state.Mutex);
+        state.Captured.clear();
+        state.FrameMarks.clear();
+        state.CaptureLimit = maxEvents;
+        state.Capturing = true;
+    }
+
+    static void EndCapture()
+    {
+        std::lock_guard lock(GetState().Mutex);
+        GetState().Capturing = false;
+    }
+
+    // Writes the captured zones in Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+    static bool WriteChromeTrace(const std::string& path)
+    {
+        State& state = GetState();
+        std::lock_guard lock(state.Mutex);
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            return false;
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&] { out << (first ? "" : ",\n"); first = false; };
+
+        for (const auto& [id, name] : state.ThreadNames)
+        {
+            separator();
+            out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << id << R"(,"args":{"name":)";
+            WriteJsonString(out, name);
+            out << "}}";
+        }
+        for (size_t i = 0; i < state.FrameMarks.size(); ++i)
+        {
+            separator();
+            out << R"({"name":"Frame )" << i << R"(","ph":"i","s":"g","pid":1,"tid":0,"ts":)";
+            WriteMicroseconds(out, state.FrameMarks[i]);
+            out << "}";
+        }
+        for (const ThreadEvent& event : state.Captured)
+        {
+            separator();
+            out << R"({"name":)";
+            WriteJsonString(out, event.Zone.Name);
+            out << R"(,"ph":"X","pid":1,"tid":)" << event.Thread << R"(,"ts":)";
+            WriteMicroseconds(out, event.Zone.Start);
+            out << R"(,"dur":)";
+            WriteMicroseconds(out, event.Zone.End - event.Zone.Start);
+            out << "}";
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+    // Zones of the last completed frame, most expensive first. Owning thread of MarkFrame only.
+    static const std::vector<ProfileZoneStats>& GetFrameSummary()
+    {
+        return GetState().Summary;
+    }
+
+    static void LogFrameSummary(size_t maxZones = 16)
+    {
+        State& state = GetState();
+        ProfilerLog::Info("Frame {}: {:.3f} ms, {} zone(s)", state.FrameIndex,
+            static_cast<double>(state.LastFrameLength) / 1e6, state.Summary.size());
+
+        const size_t count = std::min(maxZones, state.Summary.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            const ProfileZoneStats& zone = state.Summary[i];
+            ProfilerLog::Info("  {:<32} {:>5}x  incl {:>9.3f} ms  self {:>9.3f} ms", zone.Name, zone.Calls,
+                static_cast<double>(zone.Inclusive.count()) / 1e6, static_cast<double>(zone.Self.count()) / 1e6);
+        }
+    }
+
+    // Zones lost to full thread buffers or the capture limit.
+    static uint64_t GetDroppedCount()
+    {
+        std::lock_guard lock(GetState().Mutex);
+        return GetState().Dropped;
+    }
+
+private:
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(size_t capacity, uint32_t id)
+            : Events(capacity), Id(id)
+        {
+        }
+
+        utils::SpscRingBuffer<Event> Events;
+        std::atomic<uint64_t> Dropped{ 0 };
+        std::atomic<bool> Retired{ false };
+        uint32_t Id;
+    };
+
+    // Flags the buffer for removal once its thread exits and MarkFrame has drained it.
+    struct ThreadHandle
+    {
+        std::shared_ptr<ThreadBuffer> Buffer;
+
+        ~ThreadHandle()
+        {
+            if (Buffer)
+                Buffer->Retired.store(true, std::memory_order_release);
+        }
+    };
+
+    struct ThreadEvent
+    {
+        Event Zone;
+        uint32_t Thread = 0;
+    };
+
+    struct State
+    {
+        std::mutex Mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> Threads;
+        std::unordered_map<uint32_t, std::string> ThreadNames;
+        size_t BufferCapacity = 8192;
+        uint32_t NextThreadId = 1;
+        uint64_t Dropped = 0;
+
+        std::vector<ThreadEvent> FrameEvents;
+        std::vector<ProfileZoneStats> Summary;
+        std::unordered_map<std::string_view, size_t> SummaryIndex;
+        std::vector<ThreadEvent> Stack;
+        std::vector<uint64_t> ChildTime;
+        uint64_t FrameStart = 0;
+        uint64_t LastFrameLength = 0;
+        uint64_t FrameIndex = 0;
+
+        bool Capturing = false;
+        size_t CaptureLimit = 0;
+        std::vector<ThreadEvent> Captured;
+        std::vector<uint64_t> FrameMarks;
+    };
+
+    static State& GetState()
+    {
+        static State state;
+        return state;
+    }
+
+    static std::chrono::steady_clock::time_point Epoch()
+    {
+        static const auto epoch = std::chrono::steady_clock::now();
+        return epoch;
+    }
+
+    static ThreadBuffer& LocalBuffer()
+    {
+        thread_local ThreadHandle handle;
+        if (!handle.Buffer)
+        {
+            State& state = GetState();
+            std::lock_guard lock(state.Mutex);
+            handle.Buffer = std::make_shared<ThreadBuffer>(state.BufferCapacity, state.NextThreadId++);
+            state.Threads.push_back(handle.Buffer);
+        }
+        return *handle.Buffer;
+    }
+
+    // Self time comes from nesting: per thread, zones sorted by start (outer first on ties)
+    // are walked with a stack, and each zone's duration is charged against its parent.
+    static void BuildSummary(State& state)
+    {
+        auto& events = state.FrameEvents;
+        std::sort(events.begin(), events.end(), [](const ThreadEvent& a, const ThreadEvent& b) {
+            if (a.Thread != b.Thread)
+                return a.Thread < b.Thread;
+            if (a.Zone.Start != b.Zone.Start)
+                return a.Zone.Start < b.Zone.Start;
+            return a.Zone.End > b.Zone.End;
+        });
+
+        state.Summary.clear();
+        state.SummaryIndex.clear();
+        state.Stack.clear();
+        state.ChildTime.clear();
+        auto& childTime = state.ChildTime;
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const ThreadEvent& event = events[i];
+            while (!state.Stack.empty() && (state.Stack.back().Thread != event.Thread || state.Stack.back().Zone.End <= event.Zone.Start))
+            {
+                CloseZone(state, state.Stack.back(), childTime.back());
+                state.Stack.pop_back();
+                childTime.pop_back();
+            }
+
+            const uint64_t length = event.Zone.End - event.Zone.Start;
+            if (!childTime.empty())
+                childTime.back() += length;
+            state.Stack.push_back(event);
+            childTime.push_back(0);
+        }
+        while (!state.Stack.empty())
+        {
+            CloseZone(state, state.Stack.back(), childTime.back());
+            state.Stack.pop_back();
+            childTime.pop_back();
+        }
+
+        std::sort(state.Summary.begin(), state.Summary.end(), [](const ProfileZoneStats& a, const ProfileZoneStats& b) {
+            return a.Inclusive > b.Inclusive;
+        });
+        state.LastFrameLength = Now() - state.FrameStart;
+    }
+
+    static void CloseZone(State& state, const ThreadEvent& event, uint64_t childTime)
+    {
+        const std::string_view name = event.Zone.Name;
+        auto [it, inserted] = state.SummaryIndex.try_emplace(name, state.Summary.size());
+        if (inserted)
+            state.Summary.push_back({ name });
+
+        const uint64_t length = event.Zone.End - event.Zone.Start;
+        ProfileZoneStats& stats = state.Summary[it->second];
+        stats.Calls++;
+        stats.Inclusive += std::chrono::nanoseconds(length);
+        stats.Self += std::chrono::nanoseconds(length - std::min(length, childTime));
+    }
+
+    static void WriteMicroseconds(std::ostream& out, uint64_t ns)
+    {
+        out << ns / 1000 << '.' << static_cast<char>('0' + ns / 100 % 10)
+            << static_cast<char>('0' + ns / 10 % 10) << static_cast<char>('0' + ns % 10);
+    }
+
+    static void WriteJsonString(std::ostream& out, std::string_view text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+        out << '"';
+    }
+};
+
+// RAII zone: records [construction, destruction) under name on the current thread.
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(name), m_start(Profiler::Now())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        Profiler::Record(m_name, m_start, Profiler::Now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+#if defined(GAMEUTILS_ENABLE_PROFILER)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <limits>
 #include <type_traits>
 namespace raylib {
 #include "raylib/raylib.h"
@@ -7,128 +8,100 @@ namespace raylib {
 #include <string>
 #include "Size.h"
 #include "Point.h"
+#include "Thickness.h"
 
 namespace utils
 {
+    // Plain 4-value rectangle: trivially copyable and standard-layout, so arrays of them
+    // can be memcpy'd, stored densely and loaded into SIMD registers. An empty rectangle
+    // is marked by a sentinel size (EmptySize) instead of a flag; treat its Size as
+    // meaningless and check IsEmpty() first.
     template<typename T>
     struct Rectangle
     {
         // data
         Point<T> Position;
-        Size<T>  Size;
+        utils::Size<T> Size;
 
-        // refs (aliases)
-        T& X;
-        T& Y;
-        T& Width;
-        T& Height;
+        // Width and height of an empty rectangle: lowest() for signed and floating types, max() for unsigned.
+        static constexpr T EmptySize = std::is_signed_v<T> ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
 
-    private:
-        struct EmptyTag {};
-        bool m_empty;
+        // accessors
+        constexpr T& X() noexcept { return Position.X; }
+        constexpr T& Y() noexcept { return Position.Y; }
+        constexpr T& Width() noexcept { return Size.Width; }
+        constexpr T& Height() noexcept { return Size.Height; }
+        constexpr const T& X() const noexcept { return Position.X; }
+        constexpr const T& Y() const noexcept { return Position.Y; }
+        constexpr const T& Width() const noexcept { return Size.Width; }
+        constexpr const T& Height() const noexcept { return Size.Height; }
 
-    public:
         // factories
         static constexpr Rectangle<T> Zero() { return { 0, 0, 0, 0 }; }
         static constexpr Rectangle<T> FromSize(const utils::Size<T>& size) { return { 0, 0, size.Width, size.Height }; }
-        static constexpr Rectangle<T> Empty() { return Rectangle<T>(EmptyTag{}); }
-        constexpr bool IsEmpty() const noexcept { return m_empty; }
+        static constexpr Rectangle<T> Empty() { return { 0, 0, EmptySize, EmptySize }; }
+        constexpr bool IsEmpty() const noexcept { return Size.Width == EmptySize && Size.Height == EmptySize; }
 
         // ctors
         constexpr Rectangle() noexcept
-            : Position(), Size(), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height), m_empty(false) {
+            : Position(), Size() {
         }
 
         constexpr Rectangle(T x, T y) noexcept
-            : Position(x, y), Size(0, 0), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height), m_empty(false) {
+            : Position(x, y), Size(0, 0) {
         }
 
         constexpr Rectangle(T x, T y, T width, T height) noexcept
-            : Position(x, y), Size(width, height), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height), m_empty(false) {
+            : Position(x, y), Size(width, height) {
         }
 
         constexpr Rectangle(const Point<T>& pos, const utils::Size<T>& size) noexcept
-            : Position(pos), Size(size), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height), m_empty(false) {
-        }
-
-        constexpr Rectangle(const Rectangle& other)
-            : Position(other.Position), Size(other.Size),
-            X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height),
-            m_empty(other.m_empty) {
+            : Position(pos), Size(size) {
         }
 
         template<typename U>
         constexpr Rectangle(const Rectangle<U>& other) noexcept
             : Position(static_cast<T>(other.Position.X), static_cast<T>(other.Position.Y)),
-            Size(static_cast<T>(other.Size.Width), static_cast<T>(other.Size.Height)),
-            X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height),
-            m_empty(other.IsEmpty()) {
+            // An empty source's sentinel may not fit in T, so it is never converted.
+            Size(other.IsEmpty() ? utils::Size<T>(EmptySize, EmptySize)
+                : utils::Size<T>(static_cast<T>(other.Size.Width), static_cast<T>(other.Size.Height))) {
         }
 
         // assignment
-        constexpr Rectangle& operator=(const Rectangle& other)
-        {
-            if (this != &other)
-            {
-                Position = other.Position;
-                Size = other.Size;
-                m_empty = other.m_empty;
-                // refs already alias Position/Size
-            }
-            return *this;
-        }
-
-        constexpr Rectangle(Rectangle&& other) noexcept
-            : Position(std::move(other.Position)), Size(std::move(other.Size)),
-            X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height),
-            m_empty(other.m_empty) {
-        }
-
-        constexpr Rectangle& operator=(Rectangle&& other) noexcept
-        {
-            if (this != &other)
-            {
-                Position = std::move(other.Position);
-                Size = std::move(other.Size);
-                m_empty = other.m_empty;
-            }
-            return *this;
-        }
-
         constexpr Rectangle& operator=(const raylib::Rectangle& other)
         {
             Position.X = static_cast<T>(other.x);
             Position.Y = static_cast<T>(other.y);
             Size.Width = static_cast<T>(other.width);
             Size.Height = static_cast<T>(other.height);
-            m_empty = false;
             return *this;
         }
 
         // comparisons
-        constexpr bool operator==(const Rectangle& other) const { return Position == other.Position && Size == other.Size && m_empty == other.m_empty; }
+        constexpr bool operator==(const Rectangle& other) const { return Position == other.Position && Size == other.Size; }
         constexpr bool operator!=(const Rectangle& other) const { return !(*this == other); }
 
-        // arithmetic
-        constexpr Rectangle operator+(const Rectangle& other) const { Rectangle r{ Position + other.Position, Size + other.Size }; r.m_empty = m_empty && other.m_empty; return r; }
-        constexpr Rectangle operator-(const Rectangle& other) const { Rectangle r{ Position - other.Position, Size - other.Size }; r.m_empty = m_empty && other.m_empty; return r; }
-        constexpr Rectangle operator*(T scalar)            const { Rectangle r{ Position * scalar, Size * scalar }; r.m_empty = m_empty; return r; }
-        constexpr Rectangle operator/(T scalar)            const { Rectangle r{ Position / scalar, Size / scalar }; r.m_empty = m_empty; return r; }
+        // arithmetic; an empty operand counts as zero size, and empty stays empty
+        constexpr Rectangle operator+(const Rectangle& other) const { return IsEmpty() && other.IsEmpty() ? Empty() : Rectangle{ Position + other.Position, SizeOrZero() + other.SizeOrZero() }; }
+        constexpr Rectangle operator-(const Rectangle& other) const { return IsEmpty() && other.IsEmpty() ? Empty() : Rectangle{ Position - other.Position, SizeOrZero() - other.SizeOrZero() }; }
+        constexpr Rectangle operator*(T scalar)            const { return IsEmpty() ? *this : Rectangle{ Position * scalar, Size * scalar }; }
+        constexpr Rectangle operator/(T scalar)            const { return IsEmpty() ? *this : Rectangle{ Position / scalar, Size / scalar }; }
 
-        constexpr Rectangle& operator+=(const Rectangle& other) { Position += other.Position; Size += other.Size; m_empty = m_empty && other.m_empty; return *this; }
-        constexpr Rectangle& operator-=(const Rectangle& other) { Position -= other.Position; Size -= other.Size; m_empty = m_empty && other.m_empty; return *this; }
-        constexpr Rectangle& operator*=(T scalar) { Position *= scalar; Size *= scalar; return *this; }
-        constexpr Rectangle& operator/=(T scalar) { Position /= scalar; Size /= scalar; return *this; }
+        constexpr Rectangle& operator+=(const Rectangle& other) { return *this = *this + other; }
+        constexpr Rectangle& operator-=(const Rectangle& other) { return *this = *this - other; }
+        constexpr Rectangle& operator*=(T scalar) { if (!IsEmpty()) { Position *= scalar; Size *= scalar; } return *this; }
+        constexpr Rectangle& operator/=(T scalar) { if (!IsEmpty()) { Position /= scalar; Size /= scalar; } return *this; }
 
         template<typename U>
         constexpr Rectangle<std::common_type_t<T, U>> operator+(const Thickness<U>& t) const
         {
             using R = std::common_type_t<T, U>;
+            const utils::Size<T> size = SizeOrZero();
             Rectangle<R> r{
                 { static_cast<R>(Position.X) - static_cast<R>(t.Left),
                   static_cast<R>(Position.Y) - static_cast<R>(t.Top) },
-                { static_cast<R>(Size.Width) + static_cast<R>(t.Left) + static_cast<R>(t.Right),
-                  static_cast<R>(Size.Height) + static_cast<R>(t.Top) + static_cast<R>(t.Bottom) }
+                { static_cast<R>(size.Width) + static_cast<R>(t.Left) + static_cast<R>(t.Right),
+                  static_cast<R>(size.Height) + static_cast<R>(t.Top) + static_cast<R>(t.Bottom) }
             };
             return r;
         }
@@ -137,11 +110,12 @@ namespace utils
         constexpr Rectangle<std::common_type_t<T, U>> operator-(const Thickness<U>& t) const
         {
             using R = std::common_type_t<T, U>;
+            const utils::Size<T> size = SizeOrZero();
             Rectangle<R> r{
                 { static_cast<R>(Position.X) + static_cast<R>(t.Left),
                   static_cast<R>(Position.Y) + static_cast<R>(t.Top) },
-                { static_cast<R>(Size.Width) - (static_cast<R>(t.Left) + static_cast<R>(t.Right)),
-                  static_cast<R>(Size.Height) - (static_cast<R>(t.Top) + static_cast<R>(t.Bottom)) }
+                { static_cast<R>(size.Width) - (static_cast<R>(t.Left) + static_cast<R>(t.Right)),
+                  static_cast<R>(size.Height) - (static_cast<R>(t.Top) + static_cast<R>(t.Bottom)) }
             };
             return r;
         }
@@ -149,6 +123,8 @@ namespace utils
         template<typename U>
         constexpr Rectangle& operator+=(const Thickness<U>& t)
         {
+            if (IsEmpty())
+                return *this;
             using R = std::common_type_t<T, U>;
             Position.X = static_cast<T>(static_cast<R>(Position.X) - t.Left);
             Position.Y = static_cast<T>(static_cast<R>(Position.Y) - t.Top);
@@ -160,6 +136,8 @@ namespace utils
         template<typename U>
         constexpr Rectangle& operator-=(const Thickness<U>& t)
         {
+            if (IsEmpty())
+                return *this;
             using R = std::common_type_t<T, U>;
             Position.X = static_cast<T>(static_cast<R>(Position.X) + t.Left);
             Position.Y = static_cast<T>(static_cast<R>(Position.Y) + t.Top);
@@ -172,11 +150,12 @@ namespace utils
         constexpr Rectangle<std::common_type_t<T, U>> operator*(const Thickness<U>& t) const
         {
             using R = std::common_type_t<T, U>;
+            const utils::Size<T> size = SizeOrZero();
             Rectangle<R> r{
                 { static_cast<R>(Position.X) * static_cast<R>(t.Left),
                   static_cast<R>(Position.Y) * static_cast<R>(t.Top) },
-                { static_cast<R>(Size.Width) * static_cast<R>(t.Right),
-                  static_cast<R>(Size.Height) * static_cast<R>(t.Bottom) }
+                { static_cast<R>(size.Width) * static_cast<R>(t.Right),
+                  static_cast<R>(size.Height) * static_cast<R>(t.Bottom) }
             };
             return r;
         }
@@ -185,11 +164,12 @@ namespace utils
         constexpr Rectangle<std::common_type_t<T, U>> operator/(const Thickness<U>& t) const
         {
             using R = std::common_type_t<T, U>;
+            const utils::Size<T> size = SizeOrZero();
             Rectangle<R> r{
                 { static_cast<R>(Position.X) / static_cast<R>(t.Left),
                   static_cast<R>(Position.Y) / static_cast<R>(t.Top) },
-                { static_cast<R>(Size.Width) / static_cast<R>(t.Right),
-                  static_cast<R>(Size.Height) / static_cast<R>(t.Bottom) }
+                { static_cast<R>(size.Width) / static_cast<R>(t.Right),
+                  static_cast<R>(size.Height) / static_cast<R>(t.Bottom) }
             };
             return r;
         }
@@ -197,6 +177,8 @@ namespace utils
         template<typename U>
         constexpr Rectangle& operator*=(const Thickness<U>& t)
         {
+            if (IsEmpty())
+                return *this;
             using R = std::common_type_t<T, U>;
             Position.X = static_cast<T>(static_cast<R>(Position.X) * static_cast<R>(t.Left));
             Position.Y = static_cast<T>(static_cast<R>(Position.Y) * static_cast<R>(t.Top));
@@ -208,6 +190,8 @@ namespace utils
         template<typename U>
         constexpr Rectangle& operator/=(const Thickness<U>& t)
         {
+            if (IsEmpty())
+                return *this;
             using R = std::common_type_t<T, U>;
             Position.X = static_cast<T>(static_cast<R>(Position.X) / static_cast<R>(t.Left));
             Position.Y = static_cast<T>(static_cast<R>(Position.Y) / static_cast<R>(t.Top));
@@ -219,8 +203,9 @@ namespace utils
         // conversions
         constexpr explicit operator raylib::Rectangle() const
         {
+            const utils::Size<T> size = SizeOrZero();
             return { static_cast<float>(Position.X), static_cast<float>(Position.Y),
-                     static_cast<float>(Size.Width),  static_cast<float>(Size.Height) };
+                     static_cast<float>(size.Width),  static_cast<float>(size.Height) };
         }
 
         // queries
@@ -229,20 +214,26 @@ namespace utils
         template<typename U>
         constexpr bool Contains(const utils::Point<U>& point) const
         {
+            const utils::Size<T> size = SizeOrZero();
             T px = static_cast<T>(point.X);
             T py = static_cast<T>(point.Y);
-            return px >= X && px <= (X + Width) && py >= Y && py <= (Y + Height);
+            return px >= Position.X && px <= (Position.X + size.Width) && py >= Position.Y && py <= (Position.Y + size.Height);
         }
 
         std::string ToString() const
         {
-            return std::to_string(X) + ", " + std::to_string(Y) + ", " + std::to_string(Width) + ", " + std::to_string(Height);
+            const utils::Size<T> size = SizeOrZero();
+            return std::to_string(Position.X) + ", " + std::to_string(Position.Y) + ", " + std::to_string(size.Width) + ", " + std::to_string(size.Height);
         }
 
-    private:
-        // empty-tag ctor
-        constexpr Rectangle(EmptyTag) noexcept
-            : Position(), Size(), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height), m_empty(true) {
+        // The size, or zero for an empty rectangle.
+        constexpr utils::Size<T> SizeOrZero() const noexcept
+        {
+            return IsEmpty() ? utils::Size<T>() : Size;
         }
     };
+
+    static_assert(std::is_trivially_copyable_v<Rectangle<float>> && std::is_standard_layout_v<Rectangle<float>>);
+    static_assert(std::is_trivially_copyable_v<Rectangle<int>> && std::is_standard_layout_v<Rectangle<int>>);
+    static_assert(sizeof(Rectangle<float>) == 4 * sizeof(float));
 }
\ No newline at end of file
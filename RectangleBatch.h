@@ -0,0 +1,338 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "Rectangle.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || ((defined(_M_IX86) || defined(__i386__)) && defined(__SSE2__))
+#define GAMEUTILS_HAS_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define GAMEUTILS_TARGET_AVX2
+#else
+#define GAMEUTILS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace utils
+{
+    namespace detail
+    {
+        // Kernels test 64 rectangles (one mask word) per call against four bounds:
+        //   Inside:  minX >= a && minY >= b && maxX <= c && maxY <= d
+        //   !Inside: minX <= a && minY <= b && maxX >= c && maxY >= d
+        // which covers point containment, overlap and fully-within queries.
+        template<bool Inside, typename T>
+        uint64_t MatchWordScalar(const T* minX, const T* minY, const T* maxX, const T* maxY, T a, T b, T c, T d)
+        {
+            uint64_t word = 0;
+            for (uint32_t i = 0; i < 64; ++i)
+            {
+                // Non-short-circuit so the compiler can vectorize the loop.
+                const bool match = Inside
+                    ? ((minX[i] >= a) & (minY[i] >= b) & (maxX[i] <= c) & (maxY[i] <= d))
+                    : ((minX[i] <= a) & (minY[i] <= b) & (maxX[i] >= c) & (maxY[i] >= d));
+                word |= static_cast<uint64_t>(match) << i;
+            }
+            return word;
+        }
+
+#if defined(GAMEUTILS_HAS_X86_SIMD)
+        inline bool CpuHasAvx2()
+        {
+            static const bool hasAvx2 = [] {
+#if defined(_MSC_VER) && !defined(__clang__)
+                int regs[4]{};
+                __cpuid(regs, 1);
+                const bool osxsave = (regs[2] & (1 << 27)) != 0;
+                if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+                    return false;
+                __cpuidex(regs, 7, 0);
+                return (regs[1] & (1 << 5)) != 0;
+#else
+                return __builtin_cpu_supports("avx2") != 0;
+#endif
+            }();
+            return hasAvx2;
+        }
+
+        template<bool Inside>
+        uint64_t MatchWordSse2(const float* minX, const float* minY, const float* maxX, const float* maxY, float a, float b, float c, float d)
+        {
+            const __m128 va = _mm_set1_ps(a), vb = _mm_set1_ps(b), vc = _mm_set1_ps(c), vd = _mm_set1_ps(d);
+            uint64_t word = 0;
+            for (uint32_t i = 0; i < 64; i += 4)
+            {
+                const __m128 x0 = _mm_loadu_ps(minX + i), y0 = _mm_loadu_ps(minY + i);
+                const __m128 x1 = _mm_loadu_ps(maxX + i), y1 = _mm_loadu_ps(maxY + i);
+                const __m128 match = Inside
+                    ? _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x0, va), _mm_cmpge_ps(y0, vb)), _mm_and_ps(_mm_cmple_ps(x1, vc), _mm_cmple_ps(y1, vd)))
+                    : _mm_and_ps(_mm_and_ps(_mm_cmple_ps(x0, va), _mm_cmple_ps(y0, vb)), _mm_and_ps(_mm_cmpge_ps(x1, vc), _mm_cmpge_ps(y1, vd)));
+                word |= static_cast<uint64_t>(_mm_movemask_ps(match)) << i;
+            }
+            return word;
+        }
+
+        // SSE2 only has signed greater/less-than, so collect the lanes that fail and invert.
+        template<bool Inside>
+        uint64_t MatchWordSse2(const int32_t* minX, const int32_t* minY, const int32_t* maxX, const int32_t* maxY, int32_t a, int32_t b, int32_t c, int32_t d)
+        {
+            const __m128i va = _mm_set1_epi32(a), vb = _mm_set1_epi32(b), vc = _mm_set1_epi32(c), vd = _mm_set1_epi32(d);
+            uint64_t word = 0;
+            for (uint32_t i = 0; i < 64; i += 4)
+            {
+                const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(minX + i));
+                const __m128i y0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(minY + i));
+                const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maxX + i));
+                const __m128i y1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maxY + i));
+                const __m128i fail = Inside
+                    ? _mm_or_si128(_mm_or_si128(_mm_cmplt_epi32(x0, va), _mm_cmplt_epi32(y0, vb)), _mm_or_si128(_mm_cmpgt_epi32(x1, vc), _mm_cmpgt_epi32(y1, vd)))
+                    : _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(x0, va), _mm_cmpgt_epi32(y0, vb)), _mm_or_si128(_mm_cmplt_epi32(x1, vc), _mm_cmplt_epi32(y1, vd)));
+                word |= static_cast<uint64_t>(~_mm_movemask_ps(_mm_castsi128_ps(fail)) & 0xF) << i;
+            }
+            return word;
+        }
+
+        template<bool Inside>
+        GAMEUTILS_TARGET_AVX2 uint64_t MatchWordAvx2(const float* minX, const float* minY, const float* maxX, const float* maxY, float a, float b, float c, float d)
+        {
+            const __m256 va = _mm256_set1_ps(a), vb = _mm256_set1_ps(b), vc = _mm256_set1_ps(c), vd = _mm256_set1_ps(d);
+            uint64_t word = 0;
+            for (uint32_t i = 0; i < 64; i += 8)
+            {
+                const __m256 x0 = _mm256_loadu_ps(minX + i), y0 = _mm256_loadu_ps(minY + i);
+                const __m256 x1 = _mm256_loadu_ps(maxX + i), y1 = _mm256_loadu_ps(maxY + i);
+                const __m256 match = Inside
+                    ? _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(x0, va, _CMP_GE_OQ), _mm256_cmp_ps(y0, vb, _CMP_GE_OQ)),
+                        _mm256_and_ps(_mm256_cmp_ps(x1, vc, _CMP_LE_OQ), _mm256_cmp_ps(y1, vd, _CMP_LE_OQ)))
+                    : _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(x0, va, _CMP_LE_OQ), _mm256_cmp_ps(y0, vb, _CMP_LE_OQ)),
+                        _mm256_and_ps(_mm256_cmp_ps(x1, vc, _CMP_GE_OQ), _mm256_cmp_ps(y1, vd, _CMP_GE_OQ)));
+                word |= static_cast<uint64_t>(_mm256_movemask_ps(match)) << i;
+            }
+            return word;
+        }
+
+        template<bool Inside>
+        GAMEUTILS_TARGET_AVX2 uint64_t MatchWordAvx2(const int32_t* minX, const int32_t* minY, const int32_t* maxX, const int32_t* maxY, int32_t a, int32_t b, int32_t c, int32_t d)
+        {
+            const __m256i va = _mm256_set1_epi32(a), vb = _mm256_set1_epi32(b), vc = _mm256_set1_epi32(c), vd = _mm256_set1_epi32(d);
+            uint64_t word = 0;
+            for (uint32_t i = 0; i < 64; i += 8)
+            {
+                const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(minX + i));
+                const __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(minY + i));
+                const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maxX + i));
+                const __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maxY + i));
+                const __m256i fail = Inside
+                    ? _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(va, x0), _mm256_cmpgt_epi32(vb, y0)), _mm256_or_si256(_mm256_cmpgt_epi32(x1, vc), _mm256_cmpgt_epi32(y1, vd)))
+                    : _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(x0, va), _mm256_cmpgt_epi32(y0, vb)), _mm256_or_si256(_mm256_cmpgt_epi32(vc, x1), _mm256_cmpgt_epi32(vd, y1)));
+                word |= static_cast<uint64_t>(~_mm256_movemask_ps(_mm256_castsi256_ps(fail)) & 0xFF) << i;
+            }
+            return word;
+        }
+#endif
+    }
+
+    // Structure-of-arrays copy of many rectangles for bulk queries: hit-testing a point,
+    // overlap with an area, and counting rectangles fully inside an area. Bounds are
+    // kept as min/max corners padded to a multiple of 64, so each kernel call produces
+    // one 64-bit mask word. Float and int32 batches use AVX2 or SSE2 (chosen at run
+    // time); other types use a scalar loop. Edges are inclusive, as in Rectangle::Contains.
+    template<typename T>
+    class RectangleBatch
+    {
+    public:
+        static constexpr size_t LanesPerWord = 64;
+
+        RectangleBatch() = default;
+
+        explicit RectangleBatch(std::span<const Rectangle<T>> rects)
+        {
+            Assign(rects);
+        }
+
+        void Assign(std::span<const Rectangle<T>> rects)
+        {
+            Clear();
+            Reserve(rects.size());
+            for (const Rectangle<T>& rect : rects)
+                Add(rect);
+        }
+
+        uint32_t Add(const Rectangle<T>& rect)
+        {
+            const uint32_t index = static_cast<uint32_t>(m_count);
+            if (m_count == m_minX.size())
+            {
+                // Grow by a whole word of lanes, none of them live yet.
+                m_minX.resize(m_minX.size() + LanesPerWord, UnusedMin);
+                m_minY.resize(m_minY.size() + LanesPerWord, UnusedMin);
+                m_maxX.resize(m_maxX.size() + LanesPerWord, UnusedMax);
+                m_maxY.resize(m_maxY.size() + LanesPerWord, UnusedMax);
+                m_live.push_back(0);
+            }
+            Store(index, rect);
+            ++m_count;
+            return index;
+        }
+
+        void Set(uint32_t index, const Rectangle<T>& rect)
+        {
+            Store(index, rect);
+        }
+
+        // Float sizes are recomputed from the corners and may differ in the last bit.
+        Rectangle<T> Get(uint32_t index) const
+        {
+            if (!IsLive(index))
+                return Rectangle<T>::Empty();
+            return { m_minX[index], m_minY[index], static_cast<T>(m_maxX[index] - m_minX[index]), static_cast<T>(m_maxY[index] - m_minY[index]) };
+        }
+
+        void Export(std::vector<Rectangle<T>>& rects) const
+        {
+            rects.clear();
+            rects.reserve(m_count);
+            for (size_t i = 0; i < m_count; ++i)
+                rects.push_back(Get(static_cast<uint32_t>(i)));
+        }
+
+        void Clear()
+        {
+            m_minX.clear();
+            m_minY.clear();
+            m_maxX.clear();
+            m_maxY.clear();
+            m_live.clear();
+            m_count = 0;
+        }
+
+        void Reserve(size_t count)
+        {
+            const size_t lanes = (count + LanesPerWord - 1) / LanesPerWord * LanesPerWord;
+            for (std::vector<T>* bounds : { &m_minX, &m_minY, &m_maxX, &m_maxY })
+                bounds->reserve(lanes);
+            m_live.reserve(lanes / LanesPerWord);
+        }
+
+        size_t Size() const { return m_count; }
+
+        // Number of 64-bit words in a result mask.
+        size_t WordCount() const { return m_minX.size() / LanesPerWord; }
+
+        // Bit i of the mask is set when rectangle i contains the point.
+        void ContainsPoint(const Point<T>& point, std::vector<uint64_t>& mask) const
+        {
+            mask.resize(WordCount());
+            Scan<false>(point.X, point.Y, point.X, point.Y, [&](size_t word, uint64_t bits) { mask[word] = bits; });
+        }
+
+        void ContainsPoint(const Point<T>& point, std::vector<uint32_t>& indices) const
+        {
+            indices.clear();
+            Scan<false>(point.X, point.Y, point.X, point.Y, [&](size_t word, uint64_t bits) { AppendIndices(word, bits, indices); });
+        }
+
+        // Rectangles that overlap or touch the area.
+        void Overlapping(const Rectangle<T>& area, std::vector<uint64_t>& mask) const
+        {
+            mask.assign(WordCount(), 0);
+            if (!area.IsEmpty())
+                Scan<false>(Right(area), Bottom(area), area.X(), area.Y(), [&](size_t word, uint64_t bits) { mask[word] = bits; });
+        }
+
+        void Overlapping(const Rectangle<T>& area, std::vector<uint32_t>& indices) const
+        {
+            indices.clear();
+            if (!area.IsEmpty())
+                Scan<false>(Right(area), Bottom(area), area.X(), area.Y(), [&](size_t word, uint64_t bits) { AppendIndices(word, bits, indices); });
+        }
+
+        // Number of rectangles entirely inside the area.
+        size_t CountWithin(const Rectangle<T>& area) const
+        {
+            size_t count = 0;
+            if (!area.IsEmpty())
+                Scan<true>(area.X(), area.Y(), Right(area), Bottom(area), [&](size_t, uint64_t bits) { count += std::popcount(bits); });
+            return count;
+        }
+
+    private:
+        using WordKernel = uint64_t(*)(const T*, const T*, const T*, const T*, T, T, T, T);
+
+        // Padding and empty rectangles are left out of every result by the live mask.
+        // Their corners are also stored with min > max (infinities for floats), so the
+        // point and overlap kernels reject them on their own.
+        static constexpr T UnusedMin = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+        static constexpr T UnusedMax = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+
+        static T Right(const Rectangle<T>& rect) { return static_cast<T>(rect.X() + rect.Width()); }
+        static T Bottom(const Rectangle<T>& rect) { return static_cast<T>(rect.Y() + rect.Height()); }
+
+        void Store(uint32_t index, const Rectangle<T>& rect)
+        {
+            const uint64_t bit = uint64_t{ 1 } << (index % LanesPerWord);
+            if (rect.IsEmpty())
+            {
+                m_minX[index] = m_minY[index] = UnusedMin;
+                m_maxX[index] = m_maxY[index] = UnusedMax;
+                m_live[index / LanesPerWord] &= ~bit;
+                return;
+            }
+            m_live[index / LanesPerWord] |= bit;
+            m_minX[index] = rect.X();
+            m_minY[index] = rect.Y();
+            m_maxX[index] = Right(rect);
+            m_maxY[index] = Bottom(rect);
+        }
+
+        template<bool Inside>
+        static WordKernel SelectKernel()
+        {
+#if defined(GAMEUTILS_HAS_X86_SIMD)
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, int32_t>)
+            {
+                if (detail::CpuHasAvx2())
+                    return &detail::MatchWordAvx2<Inside>;
+                return &detail::MatchWordSse2<Inside>;
+            }
+#endif
+            return &detail::MatchWordScalar<Inside, T>;
+        }
+
+        template<bool Inside, typename Sink>
+        void Scan(T a, T b, T c, T d, Sink&& sink) const
+        {
+            const WordKernel kernel = SelectKernel<Inside>();
+            const size_t words = WordCount();
+            for (size_t word = 0; word < words; ++word)
+            {
+                const size_t base = word * LanesPerWord;
+                sink(word, kernel(&m_minX[base], &m_minY[base], &m_maxX[base], &m_maxY[base], a, b, c, d) & m_live[word]);
+            }
+        }
+
+        bool IsLive(uint32_t index) const
+        {
+            return (m_live[index / LanesPerWord] >> (index % LanesPerWord)) & 1;
+        }
+
+        static void AppendIndices(size_t word, uint64_t bits, std::vector<uint32_t>& indices)
+        {
+            for (; bits != 0; bits &= bits - 1)
+                indices.push_back(static_cast<uint32_t>(word * LanesPerWord + std::countr_zero(bits)));
+        }
+
+        std::vector<T> m_minX;
+        std::vector<T> m_minY;
+        std::vector<T> m_maxX;
+        std::vector<T> m_maxY;
+        std::vector<uint64_t> m_live; // one bit per lane, set for stored non-empty rectangles
+        size_t m_count = 0;
+    };
+}
\ No newline at end of file
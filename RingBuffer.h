@@ -0,0 +1,196 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace utils
+{
+    // Bounded lock-free ring buffer using a sequence number per slot.
+    // Any number of producers and consumers may run concurrently. A slot is
+    // claimed by position and stays owned by the claimer until it is published
+    // (producer) or released (consumer), so a consumer can hold several slots
+    // at once while it batches them.
+    template<typename T>
+    class LockFreeRingBuffer
+    {
+    public:
+        explicit LockFreeRingBuffer(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            m_mask = size - 1;
+            m_slots = std::make_unique<Slot[]>(size);
+            for (size_t i = 0; i < size; ++i)
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+        LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+        // Claims the next free slot for writing. Returns false when the buffer is full.
+        bool TryClaimWrite(uint64_t& pos)
+        {
+            pos = m_writePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = m_slots[pos & m_mask];
+                uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+                int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+                if (diff == 0)
+                {
+                    if (m_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return true;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = m_writePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Makes a slot claimed with TryClaimWrite visible to consumers.
+        void Publish(uint64_t pos)
+        {
+            m_slots[pos & m_mask].sequence.store(pos + 1, std::memory_order_release);
+        }
+
+        // Claims the oldest published slot for reading. Returns false when nothing is ready.
+        bool TryClaimRead(uint64_t& pos)
+        {
+            pos = m_readPos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = m_slots[pos & m_mask];
+                uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+                int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_readPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return true;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = m_readPos.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Hands a slot claimed with TryClaimRead back to producers.
+        void Release(uint64_t pos)
+        {
+            m_slots[pos & m_mask].sequence.store(pos + m_mask + 1, std::memory_order_release);
+        }
+
+        T& At(uint64_t pos) { return m_slots[pos & m_mask].value; }
+        const T& At(uint64_t pos) const { return m_slots[pos & m_mask].value; }
+
+        template<typename F>
+        bool TryPush(F&& fill)
+        {
+            uint64_t pos;
+            if (!TryClaimWrite(pos))
+                return false;
+            fill(At(pos));
+            Publish(pos);
+            return true;
+        }
+
+        template<typename F>
+        bool TryPop(F&& consume)
+        {
+            uint64_t pos;
+            if (!TryClaimRead(pos))
+                return false;
+            consume(At(pos));
+            Release(pos);
+            return true;
+        }
+
+        size_t Capacity() const { return m_mask + 1; }
+
+        // Positions only ever grow; their difference is the number of claimed slots.
+        uint64_t WritePosition() const { return m_writePos.load(std::memory_order_acquire); }
+        uint64_t ReadPosition() const { return m_readPos.load(std::memory_order_acquire); }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence{ 0 };
+            T value{};
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        size_t m_mask = 0;
+
+        alignas(64) std::atomic<uint64_t> m_writePos{ 0 };
+        alignas(64) std::atomic<uint64_t> m_readPos{ 0 };
+    };
+
+    // Bounded ring for exactly one producer thread and one consumer thread.
+    // Cheaper than LockFreeRingBuffer: no CAS, and each side caches the other's
+    // position so it only touches the shared cache line when it looks full/empty.
+    template<typename T>
+    class SpscRingBuffer
+    {
+    public:
+        explicit SpscRingBuffer(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            m_mask = size - 1;
+            m_items = std::make_unique<T[]>(size);
+        }
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        // Producer side. Returns false when the buffer is full.
+        bool TryPush(const T& value)
+        {
+            const uint64_t write = m_writePos.load(std::memory_order_relaxed);
+            if (write - m_cachedReadPos > m_mask)
+            {
+                m_cachedReadPos = m_readPos.load(std::memory_order_acquire);
+                if (write - m_cachedReadPos > m_mask)
+                    return false;
+            }
+
+            m_items[write & m_mask] = value;
+            m_writePos.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Returns false when the buffer is empty.
+        template<typename F>
+        bool TryPop(F&& consume)
+        {
+            const uint64_t read = m_readPos.load(std::memory_order_relaxed);
+            if (read == m_cachedWritePos)
+            {
+                m_cachedWritePos = m_writePos.load(std::memory_order_acquire);
+                if (read == m_cachedWritePos)
+                    return false;
+            }
+
+            consume(m_items[read & m_mask]);
+            m_readPos.store(read + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t Capacity() const { return m_mask + 1; }
+
+    private:
+        std::unique_ptr<T[]> m_items;
+        size_t m_mask = 0;
+
+        alignas(64) std::atomic<uint64_t> m_writePos{ 0 };
+        uint64_t m_cachedReadPos = 0;  // producer only
+        alignas(64) std::atomic<uint64_t> m_readPos{ 0 };
+        uint64_t m_cachedWritePos = 0; // consumer only
+    };
+}
\ No newline at end of file
@@ -0,0 +1,379 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Rectangle.h"
+
+namespace utils
+{
+    // Uniform grid broadphase over dense uint32 ids, with cells hashed into a fixed
+    // number of buckets so the world needs no bounds. Each bucket is one contiguous
+    // array of (id, cell) entries that keeps its capacity, so after warm-up inserts,
+    // moves and queries don't allocate. An object is entered in every cell its bounds
+    // touch (edges inclusive, as in Rectangle::Contains); empty rectangles occupy no cells.
+    //
+    // Queries report candidates that share a cell, not exact overlaps. An object or
+    // pair that shares several cells is reported once, from the lowest shared cell.
+    //
+    // Cell coordinates are clamped to +/-MaxCell, so far-away or infinite bounds land
+    // in the outermost cells. Objects covering more than MaxCellsPerObject cells are
+    // kept in a separate list and tested by cell range instead of being entered cell
+    // by cell; likewise a region query spanning more cells than there are objects
+    // scans the objects instead of the cells.
+    template<typename T>
+    class SpatialHashGrid
+    {
+    public:
+        static constexpr int32_t MaxCell = 1 << 30;
+        static constexpr int64_t MaxCellsPerObject = 1024;
+
+        // Throws std::invalid_argument unless cellSize is positive.
+        explicit SpatialHashGrid(T cellSize, uint32_t bucketCount = 4096)
+            : m_cellSize(cellSize)
+        {
+            if (!(cellSize > 0))
+                throw std::invalid_argument("Cell size must be positive");
+
+            uint32_t size = 1;
+            while (size < bucketCount)
+                size <<= 1;
+            m_buckets.resize(size);
+            m_bucketMask = size - 1;
+        }
+
+        // Adds the object, or moves it if the id is already present.
+        void Insert(uint32_t id, const Rectangle<T>& bounds)
+        {
+            if (id >= m_objects.size())
+                m_objects.resize(static_cast<size_t>(id) + 1);
+
+            Object& object = m_objects[id];
+            if (object.present)
+            {
+                Move(id, bounds);
+                return;
+            }
+
+            object.present = true;
+            object.bounds = bounds;
+            object.cells = CellsOf(bounds);
+            Enter(id, object);
+            ++m_count;
+        }
+
+        // Updates the bounds, touching only the cells entered or left. A move within the
+        // same cells just stores the new bounds.
+        void Move(uint32_t id, const Rectangle<T>& bounds)
+        {
+            if (!Contains(id))
+            {
+                Insert(id, bounds);
+                return;
+            }
+
+            Object& object = m_objects[id];
+            const CellRange from = object.cells;
+            const CellRange to = CellsOf(bounds);
+            object.bounds = bounds;
+            if (from == to)
+                return;
+
+            if (object.large || IsLarge(to))
+            {
+                Leave(id, object);
+                object.cells = to;
+                Enter(id, object);
+                return;
+            }
+
+            ForEachCell(from, [&](int32_t cellX, int32_t cellY) {
+                if (!to.Contains(cellX, cellY))
+                    RemoveEntry(id, cellX, cellY);
+            });
+            ForEachCell(to, [&](int32_t cellX, int32_t cellY) {
+                if (!from.Contains(cellX, cellY))
+                    AddEntry(id, cellX, cellY);
+            });
+            object.cells = to;
+        }
+
+        bool Remove(uint32_t id)
+        {
+            if (!Contains(id))
+                return false;
+
+            Object& object = m_objects[id];
+            Leave(id, object);
+            object = Object{};
+            --m_count;
+            return true;
+        }
+
+        bool Contains(uint32_t id) const
+        {
+            return id < m_objects.size() && m_objects[id].present;
+        }
+
+        const Rectangle<T>& GetBounds(uint32_t id) const
+        {
+            return m_objects[id].bounds;
+        }
+
+        // Removes every object but keeps bucket capacity for reuse.
+        void Clear()
+        {
+            for (std::vector<Entry>& bucket : m_buckets)
+                bucket.clear();
+            m_large.clear();
+            std::fill(m_objects.begin(), m_objects.end(), Object{});
+            m_count = 0;
+        }
+
+        size_t Size() const { return m_count; }
+        T GetCellSize() const { return m_cellSize; }
+
+        // Calls fn(id) for every object sharing a cell with the point.
+        template<typename F>
+        void QueryPoint(const Point<T>& point, F&& fn) const
+        {
+            const int32_t cellX = CellCoord(point.X);
+            const int32_t cellY = CellCoord(point.Y);
+            for (const Entry& entry : Bucket(cellX, cellY))
+            {
+                if (entry.cellX == cellX && entry.cellY == cellY)
+                    fn(entry.id);
+            }
+            for (uint32_t id : m_large)
+            {
+                if (m_objects[id].cells.Contains(cellX, cellY))
+                    fn(id);
+            }
+        }
+
+        // Calls fn(id) once for every object sharing a cell with the region.
+        template<typename F>
+        void QueryRegion(const Rectangle<T>& region, F&& fn) const
+        {
+            const CellRange range = CellsOf(region);
+            if (range.Count() > static_cast<int64_t>(m_objects.size()))
+            {
+                for (uint32_t id = 0; id < m_objects.size(); ++id)
+                {
+                    if (m_objects[id].present && m_objects[id].cells.Intersects(range))
+                        fn(id);
+                }
+                return;
+            }
+
+            ForEachCell(range, [&](int32_t cellX, int32_t cellY) {
+                for (const Entry& entry : Bucket(cellX, cellY))
+                {
+                    if (entry.cellX != cellX || entry.cellY != cellY)
+                        continue;
+                    const CellRange& cells = m_objects[entry.id].cells;
+                    if (cellX == std::max(cells.minX, range.minX) && cellY == std::max(cells.minY, range.minY))
+                        fn(entry.id);
+                }
+            });
+            for (uint32_t id : m_large)
+            {
+                if (m_objects[id].cells.Intersects(range))
+                    fn(id);
+            }
+        }
+
+        // Calls fn(a, b) with a < b once for every pair of objects sharing a cell.
+        template<typename F>
+        void ForEachPair(F&& fn) const
+        {
+            for (const std::vector<Entry>& bucket : m_buckets)
+            {
+                for (size_t i = 0; i < bucket.size(); ++i)
+                {
+                    const Entry& first = bucket[i];
+                    const CellRange& firstCells = m_objects[first.id].cells;
+                    for (size_t j = i + 1; j < bucket.size(); ++j)
+                    {
+                        const Entry& second = bucket[j];
+                        if (second.cellX != first.cellX || second.cellY != first.cellY)
+                            continue;
+
+                        const CellRange& secondCells = m_objects[second.id].cells;
+                        if (first.cellX == std::max(firstCells.minX, secondCells.minX) && first.cellY == std::max(firstCells.minY, secondCells.minY))
+                            fn(std::min(first.id, second.id), std::max(first.id, second.id));
+                    }
+                }
+            }
+
+            // Large objects against everything else; a pair of large ones from the lower id.
+            for (uint32_t large : m_large)
+            {
+                const CellRange& largeCells = m_objects[large].cells;
+                for (uint32_t id = 0; id < m_objects.size(); ++id)
+                {
+                    const Object& other = m_objects[id];
+                    if (id == large || !other.present || (other.large && id < large))
+                        continue;
+                    if (other.cells.Intersects(largeCells))
+                        fn(std::min(id, large), std::max(id, large));
+                }
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            uint32_t id;
+            int32_t cellX;
+            int32_t cellY;
+        };
+
+        // Inclusive cell bounds; min > max means no cells.
+        struct CellRange
+        {
+            int32_t minX = 0;
+            int32_t minY = 0;
+            int32_t maxX = -1;
+            int32_t maxY = -1;
+
+            bool Contains(int32_t cellX, int32_t cellY) const
+            {
+                return cellX >= minX && cellX <= maxX && cellY >= minY && cellY <= maxY;
+            }
+
+            bool Intersects(const CellRange& other) const
+            {
+                return std::max(minX, other.minX) <= std::min(maxX, other.maxX)
+                    && std::max(minY, other.minY) <= std::min(maxY, other.maxY);
+            }
+
+            int64_t Count() const
+            {
+                if (maxX < minX || maxY < minY)
+                    return 0;
+                return (static_cast<int64_t>(maxX) - minX + 1) * (static_cast<int64_t>(maxY) - minY + 1);
+            }
+
+            bool operator==(const CellRange&) const = default;
+        };
+
+        struct Object
+        {
+            Rectangle<T> bounds;
+            CellRange cells;
+            bool present = false;
+            bool large = false; // in m_large rather than the buckets
+        };
+
+        int32_t CellCoord(T value) const
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // NaN goes to the lowest cell, like -infinity.
+                const T cell = std::floor(value / m_cellSize);
+                if (!(cell > static_cast<T>(-MaxCell)))
+                    return -MaxCell;
+                return cell < static_cast<T>(MaxCell) ? static_cast<int32_t>(cell) : MaxCell;
+            }
+            else
+            {
+                // Round toward negative infinity like floor does for floats.
+                T cell = value / m_cellSize;
+                if constexpr (std::is_unsigned_v<T>)
+                    return cell < static_cast<T>(MaxCell) ? static_cast<int32_t>(cell) : MaxCell;
+                else
+                {
+                    if (value % m_cellSize != 0 && value < 0)
+                        --cell;
+                    return static_cast<int32_t>(std::clamp<int64_t>(cell, -MaxCell, MaxCell));
+                }
+            }
+        }
+
+        static bool IsLarge(const CellRange& range)
+        {
+            return range.Count() > MaxCellsPerObject;
+        }
+
+        void Enter(uint32_t id, Object& object)
+        {
+            object.large = IsLarge(object.cells);
+            if (object.large)
+                m_large.push_back(id);
+            else
+                ForEachCell(object.cells, [&](int32_t cellX, int32_t cellY) { AddEntry(id, cellX, cellY); });
+        }
+
+        void Leave(uint32_t id, Object& object)
+        {
+            if (object.large)
+            {
+                m_large.erase(std::find(m_large.begin(), m_large.end(), id));
+                object.large = false;
+            }
+            else
+                ForEachCell(object.cells, [&](int32_t cellX, int32_t cellY) { RemoveEntry(id, cellX, cellY); });
+        }
+
+        CellRange CellsOf(const Rectangle<T>& bounds) const
+        {
+            if (bounds.IsEmpty())
+                return {};
+            return {
+                CellCoord(bounds.X()),
+                CellCoord(bounds.Y()),
+                CellCoord(static_cast<T>(bounds.X() + bounds.Width())),
+                CellCoord(static_cast<T>(bounds.Y() + bounds.Height()))
+            };
+        }
+
+        template<typename F>
+        static void ForEachCell(const CellRange& range, F&& fn)
+        {
+            for (int32_t cellY = range.minY; cellY <= range.maxY; ++cellY)
+            {
+                for (int32_t cellX = range.minX; cellX <= range.maxX; ++cellX)
+                    fn(cellX, cellY);
+            }
+        }
+
+        uint32_t BucketIndex(int32_t cellX, int32_t cellY) const
+        {
+            return ((static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u)) & m_bucketMask;
+        }
+
+        const std::vector<Entry>& Bucket(int32_t cellX, int32_t cellY) const
+        {
+            return m_buckets[BucketIndex(cellX, cellY)];
+        }
+
+        void AddEntry(uint32_t id, int32_t cellX, int32_t cellY)
+        {
+            m_buckets[BucketIndex(cellX, cellY)].push_back({ id, cellX, cellY });
+        }
+
+        void RemoveEntry(uint32_t id, int32_t cellX, int32_t cellY)
+        {
+            std::vector<Entry>& bucket = m_buckets[BucketIndex(cellX, cellY)];
+            for (size_t i = 0; i < bucket.size(); ++i)
+            {
+                if (bucket[i].id == id && bucket[i].cellX == cellX && bucket[i].cellY == cellY)
+                {
+                    bucket[i] = bucket.back();
+                    bucket.pop_back();
+                    return;
+                }
+            }
+        }
+
+        T m_cellSize;
+        std::vector<std::vector<Entry>> m_buckets;
+        uint32_t m_bucketMask = 0;
+        std::vector<Object> m_objects;
+        std::vector<uint32_t> m_large; // ids of objects covering more than MaxCellsPerObject cells
+        size_t m_count = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#endif
+
+using namespace std::chrono;
+
+// What happened on one TickPacer::Wait.
+struct TickReport
+{
+	uint64_t Tick = 0;
+	nanoseconds Lateness{ 0 };	// wake-up time minus the deadline
+	nanoseconds Slept{ 0 };		// time spent in OS sleeps
+	nanoseconds Spun{ 0 };		// time spent in the spin/yield tail
+	uint64_t SkippedTicks = 0;	// whole periods dropped because the caller overran
+};
+
+// Holds a loop to a fixed period with low jitter, for client frame caps and server
+// tick loops alike. Most of the wait is an OS sleep, cut short by a running estimate
+// of how much the OS oversleeps; the rest is a spin that yields while far enough out.
+// Deadlines advance by exactly one period, so a late tick doesn't shift later ones.
+class TickPacer
+{
+public:
+	// Periods are clamped to [1 ns, MaxPeriod], which keeps deadlines far from overflowing.
+	static constexpr nanoseconds MaxPeriod = nanoseconds(1'000'000'000'000'000'000); // ~32 years
+	static constexpr double MinRate = 1e-9;            // one tick per MaxPeriod
+	static constexpr double MaxRate = 1'000'000'000.0; // one tick per nanosecond
+
+	explicit TickPacer(nanoseconds period)
+		: m_period(Bound(period))
+	{
+		Reset();
+	}
+
+	// Rates outside [MinRate, MaxRate] throw, as do zero, negative and non-finite ones.
+	static TickPacer FromRate(double hz)
+	{
+		if (!std::isfinite(hz) || hz <= 0.0)
+			throw std::invalid_argument("Tick rate must be positive and finite");
+		if (hz < MinRate || hz > MaxRate)
+			throw std::out_of_range("Tick rate is outside [MinRate, MaxRate]");
+
+		return TickPacer(nanoseconds(static_cast<int64_t>(1'000'000'000.0 / hz + 0.5)));
+	}
+
+	// Blocks until the next deadline and returns how well it was hit.
+	const TickReport& Wait()
+	{
+		TickReport report;
+		report.Tick = ++m_tick;
+
+		auto now = steady_clock::now();
+		const nanoseconds margin = SleepMargin();
+		while (m_deadline - now > margin)
+		{
+			const nanoseconds requested = duration_cast<nanoseconds>(m_deadline - now) - margin;
+			std::this_thread::sleep_for(requested);
+			const auto woke = steady_clock::now();
+			const nanoseconds slept = duration_cast<nanoseconds>(woke - now);
+			report.Slept += slept;
+			Learn(slept - requested);
+			now = woke;
+		}
+
+		const auto spinStart = now;
+		while (now < m_deadline)
+		{
+			if (m_deadline - now > YieldThreshold)
+				std::this_thread::yield();
+			else
+				CpuRelax();
+			now = steady_clock::now();
+		}
+		report.Spun = duration_cast<nanoseconds>(now - spinStart);
+		report.Lateness = duration_cast<nanoseconds>(now - m_deadline);
+
+		// Overran by whole periods: drop them rather than bursting to catch up.
+		m_deadline += m_period;
+		if (now >= m_deadline)
+		{
+			const auto behind = duration_cast<nanoseconds>(now - m_deadline);
+			const uint64_t skipped = static_cast<uint64_t>(behind / m_period) + 1;
+			m_deadline += m_period * static_cast<int64_t>(skipped);
+			report.SkippedTicks = skipped;
+			m_skippedTicks += skipped;
+		}
+
+		m_maxLateness = std::max(m_maxLateness, report.Lateness);
+		m_last = report;
+		return m_last;
+	}
+
+	// Restarts the schedule one period from now.
+	void Reset()
+	{
+		m_deadline = steady_clock::now() + m_period;
+		m_tick = 0;
+		m_skippedTicks = 0;
+		m_maxLateness = nanoseconds(0);
+		m_last = {};
+	}
+
+	// Takes effect from the next deadline.
+	void SetPeriod(nanoseconds period)
+	{
+		m_deadline += Bound(period) - m_period;
+		m_period = Bound(period);
+	}
+
+	nanoseconds GetPeriod() const { return m_period; }
+	const TickReport& GetLastReport() const { return m_last; }
+	nanoseconds GetMaxLateness() const { return m_maxLateness; }
+	uint64_t GetSkippedTicks() const { return m_skippedTicks; }
+
+	// Current estimate of how far past the requested time an OS sleep returns.
+	nanoseconds GetSleepOvershoot() const { return nanoseconds(static_cast<int64_t>(m_overshootMean)); }
+
+private:
+	static constexpr nanoseconds YieldThreshold = 200us;
+	static constexpr nanoseconds MinMargin = 50us;
+
+	static nanoseconds Bound(nanoseconds period)
+	{
+		return std::clamp(period, nanoseconds(1), MaxPeriod);
+	}
+
+	static void CpuRelax()
+	{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(_M_ARM64)
+		__yield();
+#elif defined(__aarch64__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+	// Sleep stops this far before the deadline: mean overshoot plus a few deviations.
+	nanoseconds SleepMargin() const
+	{
+		return std::max(MinMargin, nanoseconds(static_cast<int64_t>(m_overshootMean + 3.0 * m_overshootDeviation)));
+	}
+
+	// Exponentially weighted mean and mean deviation of sleep overshoot.
+	void Learn(nanoseconds overshoot)
+	{
+		const double sample = static_cast<double>(std::max(overshoot, nanoseconds(0)).count());
+		const double error = sample - m_overshootMean;
+		m_overshootMean += error / 8.0;
+		m_overshootDeviation += (std::abs(error) - m_overshootDeviation) / 4.0;
+	}
+
+	nanoseconds m_period;
+	steady_clock::time_point m_deadline;
+	uint64_t m_tick = 0;
+	uint64_t m_skippedTicks = 0;
+	nanoseconds m_maxLateness{ 0 };
+	TickReport m_last;
+
+	double m_overshootMean = 1'000'000.0; // start pessimistic (1 ms) and learn down
+	double m_overshootDeviation = 0.0;
+};
\ No newline at end of file
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace utils
+{
+    // Hierarchical timing wheel over dense uint32 ids (4 levels of 256 slots).
+    // Scheduling and cancelling are O(1); advancing costs O(expired) plus one
+    // cascade per 256 ticks, and runs of empty ticks are skipped via occupancy bits.
+    class TimingWheel
+    {
+    public:
+        static constexpr uint32_t SlotBits = 8;
+        static constexpr uint32_t SlotCount = 1u << SlotBits;
+        static constexpr uint32_t LevelCount = 4;
+        static constexpr uint32_t None = UINT32_MAX;
+
+        explicit TimingWheel(uint64_t currentTick = 0)
+            : m_currentTick(currentTick)
+        {
+            m_heads.fill(None);
+        }
+
+        uint64_t CurrentTick() const { return m_currentTick; }
+
+        bool IsScheduled(uint32_t id) const
+        {
+            return id < m_nodes.size() && m_nodes[id].bucket != None;
+        }
+
+        uint64_t Deadline(uint32_t id) const
+        {
+            return m_nodes[id].deadline;
+        }
+
+        // Deadlines at or before the current tick expire on the next Advance.
+        void Schedule(uint32_t id, uint64_t deadlineTick)
+        {
+            if (id >= m_nodes.size())
+                m_nodes.resize(static_cast<size_t>(id) + 1);
+            if (m_nodes[id].bucket != None)
+                Cancel(id);
+
+            m_nodes[id].deadline = deadlineTick;
+            Link(id);
+        }
+
+        void Cancel(uint32_t id)
+        {
+            if (!IsScheduled(id))
+                return;
+
+            Node& node = m_nodes[id];
+            if (node.prev != None)
+                m_nodes[node.prev].next = node.next;
+            else
+            {
+                m_heads[node.bucket] = node.next;
+                if (node.next == None)
+                    m_occupied[node.bucket / 64] &= ~(uint64_t{ 1 } << (node.bucket % 64));
+            }
+            if (node.next != None)
+                m_nodes[node.next].prev = node.prev;
+
+            node.prev = node.next = node.bucket = None;
+        }
+
+        // Moves time forward to nowTick, appending every id whose deadline passed to expired.
+        void Advance(uint64_t nowTick, std::vector<uint32_t>& expired)
+        {
+            while (m_currentTick < nowTick)
+            {
+                uint64_t tick = m_currentTick + 1;
+
+                // Nothing due in level 0 before the next cascade point: jump straight to it.
+                const uint32_t index = static_cast<uint32_t>(tick & (SlotCount - 1));
+                if (index != 0)
+                {
+                    const uint32_t next = NextOccupied(index);
+                    const uint64_t boundary = tick + (SlotCount - index);
+                    const uint64_t target = next < SlotCount ? tick + (next - index) : boundary;
+                    if (target > tick)
+                    {
+                        m_currentTick = std::min(target, nowTick + 1) - 1;
+                        continue;
+                    }
+                }
+
+                if (index == 0)
+                    Cascade(tick);
+
+                m_currentTick = tick;
+                Expire(index, tick, expired);
+            }
+        }
+
+        void Clear()
+        {
+            m_nodes.clear();
+            m_heads.fill(None);
+            m_occupied.fill(0);
+        }
+
+    private:
+        struct Node
+        {
+            uint32_t prev = None;
+            uint32_t next = None;
+            uint32_t bucket = None;
+            uint64_t deadline = 0;
+        };
+
+        void Link(uint32_t id)
+        {
+            Node& node = m_nodes[id];
+            // Slots are picked relative to the next tick Advance will process.
+            const uint64_t base = m_currentTick + 1;
+            const uint64_t deadline = std::max(node.deadline, base);
+            const uint64_t delta = deadline - base;
+
+            uint32_t level = 0;
+            while (level + 1 < LevelCount && delta >= (uint64_t{ 1 } << (SlotBits * (level + 1))))
+                ++level;
+
+            // Past the top level's range: park in its farthest slot and re-place on cascade.
+            const uint64_t maxDelta = (uint64_t{ 1 } << (SlotBits * LevelCount)) - 1;
+            const uint64_t placed = delta > maxDelta ? base + maxDelta : deadline;
+
+            const uint32_t bucket = level * SlotCount + static_cast<uint32_t>((placed >> (SlotBits * level)) & (SlotCount - 1));
+            node.bucket = bucket;
+            node.prev = None;
+            node.next = m_heads[bucket];
+            if (node.next != None)
+                m_nodes[node.next].prev = id;
+            m_heads[bucket] = id;
+            m_occupied[bucket / 64] |= uint64_t{ 1 } << (bucket % 64);
+        }
+
+        // Redistributes the higher level slots that start at tick into lower levels.
+        void Cascade(uint64_t tick)
+        {
+            uint32_t top = 1;
+            while (top + 1 < LevelCount && ((tick >> (SlotBits * top)) & (SlotCount - 1)) == 0)
+                ++top;
+
+            m_currentTick = tick - 1;
+            for (uint32_t level = top; level >= 1; --level)
+            {
+                const uint32_t bucket = level * SlotCount + static_cast<uint32_t>((tick >> (SlotBits * level)) & (SlotCount - 1));
+                uint32_t id = DetachBucket(bucket);
+                while (id != None)
+                {
+                    const uint32_t next = m_nodes[id].next;
+                    Link(id);
+                    id = next;
+                }
+            }
+        }
+
+        void Expire(uint32_t index, uint64_t tick, std::vector<uint32_t>& expired)
+        {
+            uint32_t id = DetachBucket(index);
+            while (id != None)
+            {
+                const uint32_t next = m_nodes[id].next;
+                if (m_nodes[id].deadline > tick)
+                    Link(id);
+                else
+                {
+                    m_nodes[id].prev = m_nodes[id].next = m_nodes[id].bucket = None;
+                    expired.push_back(id);
+                }
+                id = next;
+            }
+        }
+
+        uint32_t DetachBucket(uint32_t bucket)
+        {
+            const uint32_t head = m_heads[bucket];
+            m_heads[bucket] = None;
+            m_occupied[bucket / 64] &= ~(uint64_t{ 1 } << (bucket % 64));
+            return head;
+        }
+
+        // First occupied level-0 slot at or after index, or SlotCount if none.
+        uint32_t NextOccupied(uint32_t index) const
+        {
+            for (uint32_t word = index / 64; word < SlotCount / 64; ++word)
+            {
+                uint64_t bits = m_occupied[word];
+                if (word == index / 64)
+                    bits &= ~uint64_t{ 0 } << (index % 64);
+                if (bits)
+                    return word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+            }
+            return SlotCount;
+        }
+
+        uint64_t m_currentTick;
+        std::vector<Node> m_nodes;
+        std::array<uint32_t, SlotCount * LevelCount> m_heads;
+        std::array<uint64_t, SlotCount * LevelCount / 64> m_occupied{};
+    };
+}
\ No newline at end of file
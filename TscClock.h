@@ -0,0 +1,126 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GAMEUTILS_HAS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+// Steady std::chrono clock read from the CPU timestamp counter, for cheap now() calls
+// in tight loops. It is calibrated once against steady_clock on first use, and only
+// used when the CPU reports an invariant TSC. Otherwise (and off x86) now() simply
+// forwards to steady_clock. Calibration is good to some tens of ppm; use steady_clock
+// where long-term wall accuracy matters more than call cost.
+class TscClock
+{
+public:
+	using rep = int64_t;
+	using period = std::nano;
+	using duration = std::chrono::nanoseconds;
+	using time_point = std::chrono::time_point<TscClock>;
+	static constexpr bool is_steady = true;
+
+	static time_point now() noexcept
+	{
+		const Calibration& calibration = GetCalibration();
+#if defined(GAMEUTILS_HAS_TSC)
+		if (calibration.usable)
+			return time_point(duration(calibration.baseNs + static_cast<int64_t>(MulShift32(ReadCounter() - calibration.baseTicks, calibration.nsPerTickQ32))));
+#endif
+		return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+	}
+
+	// True when now() reads the TSC rather than falling back to steady_clock.
+	static bool IsTscBacked()
+	{
+		return GetCalibration().usable;
+	}
+
+	// Measured counter frequency in Hz, 0 when not TSC backed.
+	static double GetFrequency()
+	{
+		const Calibration& calibration = GetCalibration();
+		return calibration.usable ? 1e9 * 4294967296.0 / static_cast<double>(calibration.nsPerTickQ32) : 0.0;
+	}
+
+private:
+	struct Calibration
+	{
+		bool usable = false;
+		uint64_t baseTicks = 0;
+		int64_t baseNs = 0;
+		uint64_t nsPerTickQ32 = 0; // nanoseconds per tick in 32.32 fixed point
+	};
+
+	static const Calibration& GetCalibration()
+	{
+		static const Calibration calibration = Calibrate();
+		return calibration;
+	}
+
+	// (a * b) >> 32 without a 128-bit type; exact enough while b < 2^32.
+	static constexpr uint64_t MulShift32(uint64_t a, uint64_t b)
+	{
+		return (a >> 32) * b + (((a & 0xFFFFFFFFull) * b) >> 32);
+	}
+
+#if defined(GAMEUTILS_HAS_TSC)
+	static uint64_t ReadCounter()
+	{
+		return __rdtsc();
+	}
+
+	// CPUID 0x80000007 EDX bit 8: the TSC ticks at a constant rate across P/C-states.
+	static bool HasInvariantTsc()
+	{
+#if defined(_MSC_VER)
+		int regs[4]{};
+		__cpuid(regs, 0x80000000);
+		if (static_cast<unsigned>(regs[0]) < 0x80000007u)
+			return false;
+		__cpuid(regs, 0x80000007);
+		return (regs[3] & (1 << 8)) != 0;
+#else
+		unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+		if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+			return false;
+		return (edx & (1u << 8)) != 0;
+#endif
+	}
+#endif
+
+	static Calibration Calibrate()
+	{
+		using namespace std::chrono;
+		Calibration calibration;
+#if defined(GAMEUTILS_HAS_TSC)
+		if (!HasInvariantTsc())
+			return calibration;
+
+		// Busy-wait ~20 ms between two paired reads of both clocks.
+		const auto startTime = steady_clock::now();
+		const uint64_t startTicks = ReadCounter();
+		auto endTime = startTime;
+		while (endTime - startTime < 20ms)
+			endTime = steady_clock::now();
+		const uint64_t endTicks = ReadCounter();
+		if (endTicks <= startTicks)
+			return calibration;
+
+		const double ns = static_cast<double>(duration_cast<nanoseconds>(endTime - startTime).count());
+		const double ticks = static_cast<double>(endTicks - startTicks);
+		calibration.nsPerTickQ32 = static_cast<uint64_t>(ns / ticks * 4294967296.0);
+		calibration.baseTicks = endTicks;
+		calibration.baseNs = duration_cast<nanoseconds>(endTime.time_since_epoch()).count();
+		// The fixed-point multiply needs under 1 ns per tick, i.e. a TSC above 1 GHz.
+		calibration.usable = calibration.nsPerTickQ32 > 0 && calibration.nsPerTickQ32 < (uint64_t{ 1 } << 32);
+#endif
+		return calibration;
+	}
+};
\ No newline at end of file
@@ -9,4 +9,21 @@
 #include "Rectangle.h"
 #include "Alignment.h"
 #include "GUID.h"
-#include "stdextended.h"
\ No newline at end of file
+#include "stdextended.h"
+#include "RingBuffer.h"
+#include "BinaryLog.h"
+#include "TimingWheel.h"
+#include "InlineFunction.h"
+#include "FixedTimestep.h"
+#include "TickPacer.h"
+#include "Profiler.h"
+#include "LatencyHistogram.h"
+#include "FrameStats.h"
+#include "TscClock.h"
+#include "ClockSource.h"
+#include "Coroutine.h"
+#include "ChaCha20.h"
+#include "GuidMap.h"
+#include "GuidRegistry.h"
+#include "RectangleBatch.h"
+#include "SpatialHashGrid.h"
\ No newline at end of file
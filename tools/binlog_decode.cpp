@@ -0,0 +1,30 @@
+// Decodes a BinaryLog stream into the text TraceLog would have printed.
+// Usage: binlog_decode <file> [--timestamps]
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include "../BinaryLog.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <file> [--timestamps]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    const bool showTimestamps = argc > 2 && std::string_view(argv[2]) == "--timestamps";
+    if (!BinaryLogDecoder::Decode(in, std::cout, showTimestamps))
+    {
+        std::cerr << argv[1] << ": not a binary log or truncated" << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
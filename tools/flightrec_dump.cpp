@@ -0,0 +1,18 @@
+// Prints the records left in a FlightRecorder file, oldest first.
+// Usage: flightrec_dump <file>
+#include <iostream>
+#include "../FlightRecorder.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <file>" << std::endl;
+        return 2;
+    }
+
+    const auto records = FlightRecorder::ReadRecords(argv[1]);
+    for (const auto& record : records)
+        std::cout << record << '\n';
+    return records.empty() ? 1 : 0;
+}
\ No newline at end of file
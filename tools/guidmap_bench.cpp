@@ -0,0 +1,77 @@
+// Compares GuidMap against std::unordered_map<GUID, T> on inserts, hits, misses
+// and erase/insert churn near max load.
+// Usage: guidmap_bench [count]   (build with optimizations)
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include "../GuidMap.h"
+
+using Clock = std::chrono::steady_clock;
+
+template<typename F>
+static double NanosecondsPerOp(size_t ops, F&& fn)
+{
+    const auto start = Clock::now();
+    fn();
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / static_cast<double>(ops);
+}
+
+static void Report(const char* name, double guidMap, double unorderedMap)
+{
+    std::cout << name << ": GuidMap " << guidMap << " ns/op, unordered_map " << unorderedMap << " ns/op\n";
+}
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::vector<utils::GUID> keys(count * 2);
+    utils::GUID::Generate(keys);
+    const std::span<const utils::GUID> present(keys.data(), count);
+    const std::span<const utils::GUID> absent(keys.data() + count, count);
+
+    utils::GuidMap<uint32_t> guidMap;
+    std::unordered_map<utils::GUID, uint32_t> unorderedMap;
+    uint64_t sink = 0;
+
+    Report("insert",
+        NanosecondsPerOp(count, [&] { for (size_t i = 0; i < count; ++i) guidMap.Insert(present[i], static_cast<uint32_t>(i)); }),
+        NanosecondsPerOp(count, [&] { for (size_t i = 0; i < count; ++i) unorderedMap.emplace(present[i], static_cast<uint32_t>(i)); }));
+
+    Report("find hit",
+        NanosecondsPerOp(count, [&] { for (const auto& key : present) sink += *guidMap.Find(key); }),
+        NanosecondsPerOp(count, [&] { for (const auto& key : present) sink += unorderedMap.find(key)->second; }));
+
+    Report("find miss",
+        NanosecondsPerOp(count, [&] { for (const auto& key : absent) sink += guidMap.Contains(key); }),
+        NanosecondsPerOp(count, [&] { for (const auto& key : absent) sink += unorderedMap.count(key); }));
+
+    // Erase one key and insert another, keeping the size constant.
+    Report("erase+insert",
+        NanosecondsPerOp(count, [&] {
+            for (size_t i = 0; i < count; ++i)
+            {
+                guidMap.Erase(present[i]);
+                guidMap.Insert(absent[i], static_cast<uint32_t>(i));
+            }
+        }),
+        NanosecondsPerOp(count, [&] {
+            for (size_t i = 0; i < count; ++i)
+            {
+                unorderedMap.erase(present[i]);
+                unorderedMap.emplace(absent[i], static_cast<uint32_t>(i));
+            }
+        }));
+
+    if (guidMap.Size() != unorderedMap.size())
+    {
+        std::cerr << "size mismatch: " << guidMap.Size() << " vs " << unorderedMap.size() << std::endl;
+        return 1;
+    }
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Measures heap allocations and time per message through the raylib log hook,
+// against the old two-pass vsnprintf + std::string formatting.
+// Usage: loghook_bench [messages]   (build with optimizations)
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "../CustomRaylibLog.h"
+
+// Counts allocations made by the calling thread only, so the async writer is left out.
+static thread_local uint64_t allocations = 0;
+
+// Kept out of line: once GCC inlines them into the standard containers it pairs their
+// ::operator new with std::free and reports a false -Wmismatched-new-delete.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define LOGHOOK_BENCH_NOINLINE __declspec(noinline)
+#else
+#define LOGHOOK_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+LOGHOOK_BENCH_NOINLINE void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+LOGHOOK_BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+LOGHOOK_BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static void OldHook(int logLevel, const char* text, va_list args)
+{
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int len = std::vsnprintf(nullptr, 0, text, argsCopy);
+    va_end(argsCopy);
+    if (len < 0) return;
+
+    std::string message(len, '\0');
+    std::vsnprintf(message.data(), message.size() + 1, text, args);
+    TraceLog::Log(TraceLog::MapRaylibLogLevel(logLevel), "[RAYLIB]", message);
+}
+
+using Hook = void(*)(int, const char*, va_list);
+
+static void Call(Hook hook, int logLevel, const char* text, ...)
+{
+    va_list args;
+    va_start(args, text);
+    hook(logLevel, text, args);
+    va_end(args);
+}
+
+static void Run(const char* name, Hook hook, size_t messages)
+{
+    const uint64_t before = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i)
+        Call(hook, raylib::LOG_INFO, "TEXTURE: [ID %d] Texture loaded successfully (%dx%d | %s | %d mipmaps)", static_cast<int>(i), 512, 512, "R8G8B8A8", 1);
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cerr << name << ": " << static_cast<double>(allocations - before) / messages << " allocations/message, "
+        << elapsed.count() / messages << " ns/message" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+
+    // Log lines go to stdout; redirect it to /dev/null to time the hook rather than the terminal.
+    Run("old hook, sync", &OldHook, messages);
+    Run("hook, sync", &TraceLog::RaylibLogCallback, messages);
+
+    TraceLog::EnableAsync();
+    Run("old hook, async", &OldHook, messages);
+    Run("hook, async", &TraceLog::RaylibLogCallback, messages);
+    TraceLog::DisableAsync();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+// Times copying and iterating a large std::vector<utils::Rectangle<float>>, next to
+// the old layout (reference members aliasing Position/Size plus an empty flag).
+// Usage: rectangle_bench [count]   (build with optimizations)
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "../Rectangle.h"
+
+// The pre-POD layout, kept here only as a baseline.
+struct ReferenceRectangle
+{
+    utils::Point<float> Position;
+    utils::Size<float> Size;
+    float& X;
+    float& Y;
+    float& Width;
+    float& Height;
+    bool Empty = false;
+
+    ReferenceRectangle(float x, float y, float width, float height)
+        : Position(x, y), Size(width, height), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height)
+    {
+    }
+
+    ReferenceRectangle(const ReferenceRectangle& other)
+        : Position(other.Position), Size(other.Size), X(Position.X), Y(Position.Y), Width(Size.Width), Height(Size.Height), Empty(other.Empty)
+    {
+    }
+
+    ReferenceRectangle& operator=(const ReferenceRectangle& other)
+    {
+        Position = other.Position;
+        Size = other.Size;
+        Empty = other.Empty;
+        return *this;
+    }
+};
+
+template<typename F>
+static double Milliseconds(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename R, typename Area>
+static void Run(const char* name, size_t count, Area&& area)
+{
+    std::vector<R> source;
+    source.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        source.push_back(R(static_cast<float>(i % 1000), static_cast<float>(i / 1000), 4.0f, 3.0f));
+
+    std::vector<R> copy;
+    double total = 0.0;
+    const double copyMs = Milliseconds([&] { copy = source; });
+    const double iterateMs = Milliseconds([&] {
+        for (const R& rect : copy)
+            total += area(rect);
+    });
+
+    std::cout << name << " (" << sizeof(R) << " bytes): copy " << copyMs << " ms, iterate " << iterateMs
+        << " ms (checksum " << total << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    Run<ReferenceRectangle>("old layout", count, [](const ReferenceRectangle& r) { return r.Empty ? 0.0f : r.Width * r.Height; });
+    Run<utils::Rectangle<float>>("Rectangle<float>", count, [](const utils::Rectangle<float>& r) { return r.IsEmpty() ? 0.0f : r.Width() * r.Height(); });
+    return 0;
+}
\ No newline at end of file
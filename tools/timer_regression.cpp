@@ -0,0 +1,72 @@
+// Regression checks for TimerCollection callbacks that change their own timer.
+// Usage: timer_regression   (exit code 0 when every check passes)
+#include <iostream>
+#include "../GameTime.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+int main()
+{
+    auto clock = std::make_unique<ManualClock>();
+    ManualClock& manual = *clock;
+    GameTime time(std::move(clock));
+    TimerCollection timers(time);
+
+    auto step = [&](int frames) {
+        for (int i = 0; i < frames; ++i)
+        {
+            manual.Advance(10ms);
+            time.Update();
+            timers.CheckTimers();
+        }
+    };
+
+    // A repeating timer that stops itself fires once and stays stopped.
+    {
+        int fired = 0;
+        TimerHandle handle;
+        handle = timers.AddTimer(50ms, [&] { ++fired; timers.Stop(handle); }, true, TimerCollection::StartMode::StartImmediately);
+        step(100);
+        Check(fired == 1, "self-stopped repeating timer fires once");
+        Check(timers.IsValid(handle) && !timers.IsActive(handle), "self-stopped repeating timer stays stopped");
+
+        timers.Start(handle);
+        step(10);
+        Check(fired == 2, "self-stopped repeating timer can be started again");
+        timers.RemoveTimer(handle);
+    }
+
+    // A repeating timer that removes itself is gone afterwards.
+    {
+        int fired = 0;
+        TimerHandle handle;
+        handle = timers.AddTimer(50ms, [&] { ++fired; timers.RemoveTimer(handle); }, true, TimerCollection::StartMode::StartImmediately);
+        step(100);
+        Check(fired == 1 && !timers.IsValid(handle), "self-removed repeating timer fires once");
+    }
+
+    // Stop followed by Start from the callback keeps repeating.
+    {
+        int fired = 0;
+        TimerHandle handle;
+        handle = timers.AddTimer(50ms, [&] { ++fired; timers.Stop(handle); timers.Start(handle); }, true, TimerCollection::StartMode::StartImmediately);
+        step(100);
+        Check(fired >= 15, "restarted repeating timer keeps firing");
+        Check(timers.IsActive(handle), "restarted repeating timer stays active");
+        timers.RemoveTimer(handle);
+    }
+
+    Check(timers.Size() == 0, "all timers removed");
+    if (failures == 0)
+        std::cout << "all timer checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file